@@ -40,6 +40,12 @@
 
 #define BORDER_WIDTH_MAX 0xffff
 
+/* Images are converted in horizontal bands of this many lines in parallel */
+#define RENDER_BAND_LINES 32
+#define RENDER_BANDS_MAX 32
+/* Smaller images are converted directly, splitting them isn't worth the dispatch */
+#define RENDER_BAND_MIN_HEIGHT 64
+
 
 /* For border auto hiding */
 /* Number of consecutive frames border must not change until it's hidden */
@@ -57,6 +63,7 @@ static size_t border_animation[] = {
 static size_t num_animation = sizeof(border_animation) / sizeof(border_animation[0]);
 
 static int get_border_color(const RendererImage *image, const uint32_t *palette);
+static BOOL render_lines(const uint8_t *source, size_t sourceRowSize, uint32_t *destination, size_t destinationRowSize, size_t width, size_t height, BOOL doubleLines, const uint32_t *palette);
 
 
 @implementation Renderer
@@ -129,27 +136,32 @@ static int get_border_color(const RendererImage *image, const uint32_t *palette)
 
     const uint8_t *source = image->data;
     uint32_t *destination = [self dataAt:rect.origin];
-    
-    for (size_t y = 0; y < rect.size.height; y++) {
-        BOOL lineChanged = NO;
-        for (size_t x = 0; x < rect.size.width; x++) {
-            uint32_t value = _palette[source[x]];
-            if (destination[x] != value) {
-                lineChanged = YES;
-                destination[x] = value;
-            }
-        }
-        
-        if (_doubleLines) {
-            if (lineChanged) {
-                memcpy(destination + _size.width, destination, rect.size.width * sizeof(destination[0]));
-            }
-            destination += _size.width;
-        }
-        
-        _changed |= lineChanged;
-        source += image->rowSize;
-        destination += _size.width;
+    size_t bands = MY_MIN((rect.size.height + RENDER_BAND_LINES - 1) / RENDER_BAND_LINES, RENDER_BANDS_MAX);
+
+    if (rect.size.height <= RENDER_BAND_MIN_HEIGHT) {
+        _changed |= render_lines(source, image->rowSize, destination, _size.width, rect.size.width, rect.size.height, _doubleLines, _palette);
+        return;
+    }
+
+    /* Palette expansion has no vertical kernel, so bands don't need to overlap. */
+    BOOL bandChanged[RENDER_BANDS_MAX];
+    BOOL *changed = bandChanged;
+    size_t bandHeight = (rect.size.height + bands - 1) / bands;
+    size_t sourceRowSize = image->rowSize;
+    size_t destinationRowSize = _size.width;
+    size_t width = rect.size.width;
+    size_t height = rect.size.height;
+    BOOL doubleLines = _doubleLines;
+    const uint32_t *palette = _palette;
+
+    dispatch_apply(bands, DISPATCH_APPLY_AUTO, ^(size_t band) {
+        size_t y = band * bandHeight;
+        size_t lines = y < height ? MY_MIN(bandHeight, height - y) : 0;
+        changed[band] = render_lines(source + y * sourceRowSize, sourceRowSize, destination + y * destinationRowSize * (doubleLines ? 2 : 1), destinationRowSize, width, lines, doubleLines, palette);
+    });
+
+    for (size_t band = 0; band < bands; band++) {
+        _changed |= bandChanged[band];
     }
 }
 
@@ -346,6 +358,35 @@ static int get_border_color(const RendererImage *image, const uint32_t *palette)
 @end
 
 
+static BOOL render_lines(const uint8_t *source, size_t sourceRowSize, uint32_t *destination, size_t destinationRowSize, size_t width, size_t height, BOOL doubleLines, const uint32_t *palette) {
+    BOOL changed = NO;
+
+    for (size_t y = 0; y < height; y++) {
+        BOOL lineChanged = NO;
+        for (size_t x = 0; x < width; x++) {
+            uint32_t value = palette[source[x]];
+            if (destination[x] != value) {
+                lineChanged = YES;
+                destination[x] = value;
+            }
+        }
+
+        if (doubleLines) {
+            if (lineChanged) {
+                memcpy(destination + destinationRowSize, destination, width * sizeof(destination[0]));
+            }
+            destination += destinationRowSize;
+        }
+
+        changed |= lineChanged;
+        source += sourceRowSize;
+        destination += destinationRowSize;
+    }
+
+    return changed;
+}
+
+
 void renderer_image_free(RendererImage *image) {
     if (image) {
         free(image->data);
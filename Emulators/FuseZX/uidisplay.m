@@ -28,6 +28,8 @@
  IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <string.h>
+
 #include "fuse.h"
 #include "ui/ui.h"
 
@@ -55,6 +57,29 @@ static uint32_t palette[] = {
     0xFFFFFFFF
 };
 
+/* expand_table[data] has 0xff in each byte whose pixel is set in data,
+   laid out in memory order so it can be blended directly into the
+   8-bit screen buffer. */
+static uint64_t expand_table[256];
+
+static void init_expand_table(void) {
+    for (int data = 0; data < 256; data++) {
+        uint8_t bytes[8];
+
+        for (int i = 0; i < 8; i++) {
+            bytes[i] = data & (0x80 >> i) ? 0xff : 0x00;
+        }
+        memcpy(&expand_table[data], bytes, sizeof(bytes));
+    }
+}
+
+static inline void plot_byte(uint8_t *dest, libspectrum_byte data, uint64_t ink, uint64_t paper) {
+    uint64_t mask = expand_table[data];
+    uint64_t pixels = (ink & mask) | (paper & ~mask);
+
+    memcpy(dest, &pixels, sizeof(pixels));
+}
+
 void uidisplay_area(int x, int y, int w, int h) {
     RendererPoint offset = {x, y};
     RendererImage image;
@@ -81,6 +106,8 @@ int uidisplay_hotswap_gfx_mode(void) {
 }
 
 int uidisplay_init(int width, int height) {
+    init_expand_table();
+
     if ((screen = renderer_image_new(width, height)) == NULL) {
         fuse_exiting = 1;
         return 0;
@@ -108,21 +135,18 @@ int uidisplay_init(int width, int height) {
 
 void uidisplay_plot8(int x, int y, libspectrum_byte data, libspectrum_byte ink, libspectrum_byte paper) {
     uint8_t *dest = screen->data + y * screen->rowSize + x * 8;
-    
-    for (uint8_t mask = 0x80; mask != 0; mask >>= 1) {
-        *dest = data & mask ? ink : paper;
-        dest += 1;
-    }
+
+    plot_byte(dest, data, ink * 0x0101010101010101ULL, paper * 0x0101010101010101ULL);
 }
 
 
 void uidisplay_plot16(int x, int y, libspectrum_word data, libspectrum_byte ink, libspectrum_byte paper) {
     uint8_t *dest = screen->data + y * screen->rowSize + x * 16;
-    
-    for (uint16_t mask = 0x8000; mask != 0; mask >>= 1) {
-        *dest = data & mask ? ink : paper;
-        dest += 1;
-    }
+    uint64_t ink8 = ink * 0x0101010101010101ULL;
+    uint64_t paper8 = paper * 0x0101010101010101ULL;
+
+    plot_byte(dest, data >> 8, ink8, paper8);
+    plot_byte(dest + 8, data & 0xff, ink8, paper8);
 }
 
 
@@ -48,6 +48,7 @@
 #include "viciitypes.h"
 #include "lightpen.h"
 #include "mousedrv.h"
+#include "vsync.h"
 
 #import <CoreImage/CoreImage.h>
 #import "ViceThread.h"
@@ -144,6 +145,10 @@ void video_canvas_destroy(struct video_canvas_s *canvas) {
 
 /** \brief Update the display on a video canvas to reflect the machine
  *         state.
+ *
+ * The palette indexed draw buffer is handed to Renderer as is, so VICE's
+ * own renderers, including the PAL and CRT emulation, are never used.
+ *
  * \param canvas The canvas to update.
  * \param xs     A parameter to forward to video_canvas_render()
  * \param ys     A parameter to forward to video_canvas_render()
@@ -301,7 +306,10 @@ void vsyncarch_presync(void) {
         return;
     }
 
-    [viceThread displayImage];
+    /* don't hand undrawn frames to the renderer in warp mode */
+    if (!vsync_frame_skipped()) {
+        [viceThread displayImage];
+    }
     
     lightpen_update(0, lightpen_x, lightpen_y, lightpen_buttons);
     kbdbuf_flush();
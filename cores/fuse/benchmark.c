@@ -0,0 +1,180 @@
+/* benchmark.c: Headless emulation throughput measurement
+   Copyright (c) 2026 The Ready authors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: ready@tpau.group
+
+*/
+
+#include <config.h>
+
+#include <stdio.h>
+
+#include <libspectrum.h>
+
+#include "benchmark.h"
+#include "debugger/debugger.h"
+#include "display.h"
+#include "event.h"
+#include "fuse.h"
+#include "machine.h"
+#include "settings.h"
+#include "sound.h"
+#include "timer/timer.h"
+#include "z80/z80.h"
+
+/* 32-bit FNV-1a, used to fingerprint the display and sound output so
+   that changes to the emulation show up alongside changes in speed */
+#define HASH_OFFSET_BASIS 0x811c9dc5UL
+#define HASH_PRIME 0x01000193UL
+
+int benchmark_active = 0;
+
+static const char * const subsystem_names[ BENCHMARK_SUBSYSTEM_COUNT ] = {
+  "Emulation",
+  "Sound",
+  "Display",
+};
+
+static double subsystem_time[ BENCHMARK_SUBSYSTEM_COUNT ];
+static double lap_start;
+
+static libspectrum_dword frames;
+static double tstates_run;
+
+static libspectrum_dword sound_hash;
+
+static libspectrum_dword
+hash_byte( libspectrum_dword hash, libspectrum_byte byte )
+{
+  return ( ( hash ^ byte ) * HASH_PRIME ) & 0xffffffffUL;
+}
+
+static libspectrum_dword
+hash_dword( libspectrum_dword hash, libspectrum_dword value )
+{
+  hash = hash_byte( hash, value & 0xff );
+  hash = hash_byte( hash, ( value >> 8 ) & 0xff );
+  hash = hash_byte( hash, ( value >> 16 ) & 0xff );
+  return hash_byte( hash, value >> 24 );
+}
+
+static libspectrum_dword
+display_hash( void )
+{
+  libspectrum_dword hash = HASH_OFFSET_BASIS;
+  size_t i;
+
+  for( i = 0; i < DISPLAY_SCREEN_WIDTH_COLS * DISPLAY_SCREEN_HEIGHT; i++ )
+    hash = hash_dword( hash, display_last_screen[i] );
+
+  return hash;
+}
+
+/* Charge the time since the last lap to `subsystem' */
+void
+benchmark_lap( benchmark_subsystem subsystem )
+{
+  double now = timer_get_time();
+
+  subsystem_time[ subsystem ] += now - lap_start;
+  lap_start = now;
+}
+
+void
+benchmark_frame( libspectrum_dword frame_length )
+{
+  tstates_run += frame_length;
+
+  if( ++frames >= (libspectrum_dword)settings_current.benchmark )
+    fuse_exiting = 1;
+}
+
+void
+benchmark_sound_frame( libspectrum_signed_word *samples, int count )
+{
+  int i;
+
+  for( i = 0; i < count; i++ ) {
+    sound_hash = hash_byte( sound_hash, samples[i] & 0xff );
+    sound_hash = hash_byte( sound_hash, ( samples[i] >> 8 ) & 0xff );
+  }
+}
+
+static void
+print_report( double elapsed )
+{
+  double real_frames_per_second, frames_per_second;
+  int i;
+
+  real_frames_per_second = (double)machine_current->timings.processor_speed /
+                           machine_current->timings.tstates_per_frame;
+  frames_per_second = frames / elapsed;
+
+  printf( "Machine: %s\n",
+          libspectrum_machine_name( machine_current->machine ) );
+  printf( "Frames: %lu\n", (unsigned long)frames );
+  printf( "Time: %.3f s\n", elapsed );
+  printf( "Frames/sec: %.1f (%.0f%% of real time)\n", frames_per_second,
+          100 * frames_per_second / real_frames_per_second );
+  printf( "T-states/sec: %.0f\n", tstates_run / elapsed );
+
+  for( i = 0; i < BENCHMARK_SUBSYSTEM_COUNT; i++ ) {
+    printf( "%s: %.3f s (%.1f%%)\n", subsystem_names[i], subsystem_time[i],
+            100 * subsystem_time[i] / elapsed );
+  }
+
+  printf( "Display hash: %08lx\n", (unsigned long)display_hash() );
+  if( sound_enabled ) {
+    printf( "Sound hash: %08lx\n", (unsigned long)sound_hash );
+  } else {
+    printf( "Sound hash: none (sound not generated)\n" );
+  }
+}
+
+/* Run the emulation flat out for the number of frames given by the
+   --benchmark option, then report how fast it went */
+int
+benchmark_run( void )
+{
+  double start, elapsed;
+  int i;
+
+  for( i = 0; i < BENCHMARK_SUBSYSTEM_COUNT; i++ ) subsystem_time[i] = 0;
+  frames = 0;
+  tstates_run = 0;
+  sound_hash = HASH_OFFSET_BASIS;
+
+  benchmark_active = 1;
+  start = lap_start = timer_get_time();
+
+  while( !fuse_exiting ) {
+    z80_do_opcodes();
+    event_do_events();
+  }
+
+  benchmark_lap( BENCHMARK_EMULATION );
+  elapsed = lap_start - start;
+
+  benchmark_active = 0;
+
+  if( elapsed <= 0 ) elapsed = 1e-6;
+  print_report( elapsed );
+
+  return debugger_get_exit_code();
+}
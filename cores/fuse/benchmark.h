@@ -0,0 +1,47 @@
+/* benchmark.h: Headless emulation throughput measurement
+   Copyright (c) 2026 The Ready authors
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+   Author contact information:
+
+   E-mail: ready@tpau.group
+
+*/
+
+#ifndef FUSE_BENCHMARK_H
+#define FUSE_BENCHMARK_H
+
+#include <libspectrum.h>
+
+/* The parts of each frame which are timed separately */
+typedef enum benchmark_subsystem {
+
+  BENCHMARK_EMULATION,		/* Z80, contention, scanline events */
+  BENCHMARK_SOUND,		/* Beeper and AY synthesis */
+  BENCHMARK_DISPLAY,		/* End of frame display update */
+
+  BENCHMARK_SUBSYSTEM_COUNT
+
+} benchmark_subsystem;
+
+extern int benchmark_active;
+
+int benchmark_run( void );
+void benchmark_lap( benchmark_subsystem subsystem );
+void benchmark_frame( libspectrum_dword frame_length );
+void benchmark_sound_frame( libspectrum_signed_word *samples, int count );
+
+#endif			/* #ifndef FUSE_BENCHMARK_H */
@@ -27,6 +27,7 @@
 #include <config.h>
 
 #include <ctype.h>
+#include <stdio.h>
 #include <string.h>
 
 #include <libspectrum.h>
@@ -44,6 +45,15 @@ GSList *debugger_breakpoints;
 /* The next breakpoint ID to use */
 static size_t next_breakpoint_id;
 
+/* For each of the address and port breakpoint types, a bitmap of the 16-bit
+   values at which a breakpoint of that type could trigger. Most checks can
+   then be rejected without walking the breakpoint list */
+#define BREAKPOINT_MAP_TYPES ( DEBUGGER_BREAKPOINT_TYPE_PORT_WRITE + 1 )
+static libspectrum_byte breakpoint_map[ BREAKPOINT_MAP_TYPES ][ 0x10000 / 8 ];
+
+/* Set whenever breakpoints are added or removed */
+static int breakpoint_map_dirty = 1;
+
 /* Textual representations of the breakpoint types and lifetimes */
 const char *debugger_breakpoint_type_text[] = {
   "Execute", "Read", "Write", "Port Read", "Port Write", "Time", "Event",
@@ -78,6 +88,7 @@ static gint find_breakpoint_by_address( gconstpointer data,
 					gconstpointer user_data );
 static void free_breakpoint( gpointer data, gpointer user_data );
 static void add_time_event( gpointer data, gpointer user_data );
+static void update_breakpoint_map( void );
 
 /* Add a breakpoint */
 int
@@ -212,6 +223,7 @@ breakpoint_add( debugger_breakpoint_type type, debugger_breakpoint_value value,
   bp->commands = NULL;
 
   debugger_breakpoints = g_slist_append( debugger_breakpoints, bp );
+  breakpoint_map_dirty = 1;
 
   if( debugger_mode == DEBUGGER_MODE_INACTIVE )
     debugger_mode = DEBUGGER_MODE_ACTIVE;
@@ -240,6 +252,13 @@ debugger_check( debugger_breakpoint_type type, libspectrum_dword value )
   case DEBUGGER_MODE_INACTIVE: return 0;
 
   case DEBUGGER_MODE_ACTIVE:
+    if( type < BREAKPOINT_MAP_TYPES ) {
+      if( breakpoint_map_dirty ) update_breakpoint_map();
+      if( !( breakpoint_map[ type ][ ( value & 0xffff ) >> 3 ] &
+             ( 1 << ( value & 0x07 ) ) ) )
+        return 0;
+    }
+
     for( ptr = debugger_breakpoints; ptr; ptr = ptr_next ) {
 
       bp = ptr->data;
@@ -251,6 +270,7 @@ debugger_check( debugger_breakpoint_type type, libspectrum_dword value )
 
         if( bp->life == DEBUGGER_BREAKPOINT_LIFE_ONESHOT ) {
           debugger_breakpoints = g_slist_remove( debugger_breakpoints, bp );
+          breakpoint_map_dirty = 1;
           libspectrum_free( bp );
           signal_breakpoints_updated = 1;
         }
@@ -270,6 +290,56 @@ debugger_check( debugger_breakpoint_type type, libspectrum_dword value )
   return ( debugger_mode == DEBUGGER_MODE_HALTED );
 }
 
+static void
+breakpoint_map_set( debugger_breakpoint_type type, libspectrum_word value )
+{
+  breakpoint_map[ type ][ value >> 3 ] |= 1 << ( value & 0x07 );
+}
+
+/* Rebuild the breakpoint bitmaps from the list of breakpoints */
+static void
+update_breakpoint_map( void )
+{
+  GSList *ptr;
+  debugger_breakpoint *bp;
+  libspectrum_dword i;
+
+  memset( breakpoint_map, 0, sizeof( breakpoint_map ) );
+
+  for( ptr = debugger_breakpoints; ptr; ptr = ptr->next ) {
+    bp = ptr->data;
+
+    switch( bp->type ) {
+
+    case DEBUGGER_BREAKPOINT_TYPE_EXECUTE:
+    case DEBUGGER_BREAKPOINT_TYPE_READ:
+    case DEBUGGER_BREAKPOINT_TYPE_WRITE:
+      if( bp->value.address.source == memory_source_any ) {
+        breakpoint_map_set( bp->type, bp->value.address.offset );
+      } else {
+        /* The page could be mapped in at any 16K boundary */
+        for( i = 0; i < 0x10000; i += 0x4000 )
+          breakpoint_map_set( bp->type, i | ( bp->value.address.offset & 0x3fff ) );
+      }
+      break;
+
+    case DEBUGGER_BREAKPOINT_TYPE_PORT_READ:
+    case DEBUGGER_BREAKPOINT_TYPE_PORT_WRITE:
+      for( i = 0; i < 0x10000; i++ )
+        if( ( i & bp->value.port.mask ) == bp->value.port.port )
+          breakpoint_map_set( bp->type, i );
+      break;
+
+    case DEBUGGER_BREAKPOINT_TYPE_TIME:
+    case DEBUGGER_BREAKPOINT_TYPE_EVENT:
+      break;
+
+    }
+  }
+
+  breakpoint_map_dirty = 0;
+}
+
 void
 debugger_breakpoint_reduce_tstates( libspectrum_dword tstates )
 {
@@ -386,6 +456,7 @@ debugger_breakpoint_remove( size_t id )
   bp = get_breakpoint_by_id( id ); if( !bp ) return 1;
 
   debugger_breakpoints = g_slist_remove( debugger_breakpoints, bp );
+  breakpoint_map_dirty = 1;
   if( debugger_mode == DEBUGGER_MODE_ACTIVE && !debugger_breakpoints )
     debugger_mode = DEBUGGER_MODE_INACTIVE;
 
@@ -468,6 +539,7 @@ debugger_breakpoint_clear( libspectrum_word address )
 
     ptr_data = ptr->data;
     debugger_breakpoints = g_slist_remove( debugger_breakpoints, ptr_data );
+    breakpoint_map_dirty = 1;
     if( debugger_mode == DEBUGGER_MODE_ACTIVE && !debugger_breakpoints )
       debugger_mode = DEBUGGER_MODE_INACTIVE;
 
@@ -510,6 +582,7 @@ debugger_breakpoint_remove_all( void )
 {
   g_slist_foreach( debugger_breakpoints, free_breakpoint, NULL );
   g_slist_free( debugger_breakpoints ); debugger_breakpoints = NULL;
+  breakpoint_map_dirty = 1;
 
   if( debugger_mode == DEBUGGER_MODE_ACTIVE )
     debugger_mode = DEBUGGER_MODE_INACTIVE;
@@ -621,3 +694,49 @@ debugger_breakpoint_time_fn( libspectrum_dword tstates, int type GCC_UNUSED,
 {
   debugger_check( DEBUGGER_BREAKPOINT_TYPE_TIME, 0 );
 }
+
+int
+debugger_breakpoint_unittest( void )
+{
+  int r = 0;
+
+  debugger_breakpoint_remove_all();
+
+  debugger_breakpoint_add_address( DEBUGGER_BREAKPOINT_TYPE_EXECUTE,
+                                   memory_source_any, 0, 0x8000, 0,
+                                   DEBUGGER_BREAKPOINT_LIFE_PERMANENT, NULL );
+  debugger_breakpoint_add_port( DEBUGGER_BREAKPOINT_TYPE_PORT_READ, 0x00fe,
+                                0x00ff, 0, DEBUGGER_BREAKPOINT_LIFE_PERMANENT,
+                                NULL );
+
+  if( debugger_check( DEBUGGER_BREAKPOINT_TYPE_EXECUTE, 0x8001 ) ||
+      debugger_check( DEBUGGER_BREAKPOINT_TYPE_READ, 0x8000 ) ||
+      debugger_check( DEBUGGER_BREAKPOINT_TYPE_PORT_READ, 0x12fd ) ||
+      debugger_check( DEBUGGER_BREAKPOINT_TYPE_PORT_WRITE, 0x12fe ) ) {
+    printf( "%s:%d: breakpoint triggered unexpectedly\n", __FILE__, __LINE__ );
+    r = 1;
+  }
+
+  if( !debugger_check( DEBUGGER_BREAKPOINT_TYPE_EXECUTE, 0x8000 ) ) {
+    printf( "%s:%d: execute breakpoint did not trigger\n", __FILE__, __LINE__ );
+    r = 1;
+  }
+
+  debugger_run();
+
+  if( !debugger_check( DEBUGGER_BREAKPOINT_TYPE_PORT_READ, 0x12fe ) ) {
+    printf( "%s:%d: port breakpoint did not trigger\n", __FILE__, __LINE__ );
+    r = 1;
+  }
+
+  /* Removed breakpoints must no longer trigger */
+  debugger_breakpoint_remove_all();
+  debugger_run();
+
+  if( debugger_check( DEBUGGER_BREAKPOINT_TYPE_EXECUTE, 0x8000 ) ) {
+    printf( "%s:%d: removed breakpoint triggered\n", __FILE__, __LINE__ );
+    r = 1;
+  }
+
+  return r;
+}
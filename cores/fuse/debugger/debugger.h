@@ -96,5 +96,6 @@ void debugger_system_variable_register(
 
 /* Unit tests */
 int debugger_disassemble_unittest( void );
+int debugger_breakpoint_unittest( void );
 
 #endif				/* #ifndef FUSE_DEBUGGER_H */
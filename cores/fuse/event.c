@@ -23,6 +23,7 @@
 
 #include <config.h>
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <libspectrum.h>
@@ -39,10 +40,16 @@ static const libspectrum_dword event_no_events = 0xffffffff;
 /* When will the next event happen? */
 libspectrum_dword event_next_event;
 
-/* The actual list of events */
-static GSList *event_list = NULL;
+/* The pending events, kept as a binary min-heap ordered on time, then
+   type, then the order in which they were added */
+static event_t **event_heap = NULL;
+static size_t event_count = 0;
+static size_t event_heap_size = 0;
 
-/* An event ready to be reused */
+/* Sequence number to be given to the next event added */
+static libspectrum_dword event_sequence = 0;
+
+/* Events ready to be reused, linked through their `next_free' field */
 static event_t *event_free = NULL;
 
 /* A null event */
@@ -80,13 +87,79 @@ event_register( event_fn_t fn, const char *description )
   return registered_events->len - 1;
 }
 
-static gint
-event_add_cmp( gconstpointer a1, gconstpointer b1 )
+/* Does event `a' happen before event `b'? */
+static int
+event_before( const event_t *a, const event_t *b )
+{
+  if( a->tstates != b->tstates ) return a->tstates < b->tstates;
+  if( a->type != b->type ) return a->type < b->type;
+  return (libspectrum_signed_dword)( a->sequence - b->sequence ) < 0;
+}
+
+static int
+event_compare( const void *a1, const void *b1 )
+{
+  const event_t *a = *(event_t * const *)a1, *b = *(event_t * const *)b1;
+
+  return event_before( a, b ) ? -1 : event_before( b, a ) ? 1 : 0;
+}
+
+/* Move the event at `index' towards the root until the heap is valid */
+static void
+event_sift_up( size_t index )
+{
+  event_t *ptr = event_heap[ index ];
+
+  while( index ) {
+    size_t parent = ( index - 1 ) / 2;
+    if( !event_before( ptr, event_heap[ parent ] ) ) break;
+    event_heap[ index ] = event_heap[ parent ];
+    index = parent;
+  }
+
+  event_heap[ index ] = ptr;
+}
+
+/* Move the event at `index' towards the leaves until the heap is valid */
+static void
+event_sift_down( size_t index )
+{
+  event_t *ptr = event_heap[ index ];
+
+  while( 1 ) {
+    size_t child = 2 * index + 1;
+    if( child >= event_count ) break;
+    if( child + 1 < event_count &&
+        event_before( event_heap[ child + 1 ], event_heap[ child ] ) )
+      child++;
+    if( !event_before( event_heap[ child ], ptr ) ) break;
+    event_heap[ index ] = event_heap[ child ];
+    index = child;
+  }
+
+  event_heap[ index ] = ptr;
+}
+
+/* Restore the heap property for the whole heap */
+static void
+event_heapify( void )
+{
+  size_t i;
+
+  for( i = event_count / 2; i > 0; i-- ) event_sift_down( i - 1 );
+}
+
+static void
+event_update_next_event( void )
 {
-  const event_t *a = a1, *b = b1;
+  event_next_event = event_count ? event_heap[0]->tstates : event_no_events;
+}
 
-  return a->tstates != b->tstates ? a->tstates - b->tstates
-		                  : a->type - b->type;
+static void
+event_release( event_t *ptr )
+{
+  ptr->next_free = event_free;
+  event_free = ptr;
 }
 
 /* Add an event at the correct place in the event list */
@@ -97,7 +170,7 @@ event_add_with_data( libspectrum_dword event_time, int type, void *user_data )
 
   if( event_free ) {
     ptr = event_free;
-    event_free = NULL;
+    event_free = ptr->next_free;
   } else {
     ptr = libspectrum_new( event_t, 1 );
   }
@@ -105,13 +178,17 @@ event_add_with_data( libspectrum_dword event_time, int type, void *user_data )
   ptr->tstates = event_time;
   ptr->type =type;
   ptr->user_data = user_data;
+  ptr->sequence = event_sequence++;
 
-  if( event_time < event_next_event ) {
-    event_next_event = event_time;
-    event_list = g_slist_prepend( event_list, ptr );
-  } else {
-    event_list = g_slist_insert_sorted( event_list, ptr, event_add_cmp );
+  if( event_count == event_heap_size ) {
+    event_heap_size = event_heap_size ? 2 * event_heap_size : 16;
+    event_heap = libspectrum_renew( event_t*, event_heap, event_heap_size );
   }
+
+  event_heap[ event_count ] = ptr;
+  event_sift_up( event_count++ );
+
+  if( event_time < event_next_event ) event_next_event = event_time;
 }
 
 /* Do all events which have passed */
@@ -122,48 +199,36 @@ event_do_events( void )
 
   while(event_next_event <= tstates) {
     event_descriptor_t descriptor;
-    ptr = event_list->data;
+    ptr = event_heap[0];
     descriptor =
       g_array_index( registered_events, event_descriptor_t, ptr->type );
 
-    /* Remove the event from the list *before* processing */
-    event_list = g_slist_remove( event_list, ptr );
-
-    if( event_list == NULL ) {
-      event_next_event = event_no_events;
-    } else {
-      event_next_event = ((event_t*)(event_list->data))->tstates;
+    /* Remove the event from the heap *before* processing */
+    if( --event_count ) {
+      event_heap[0] = event_heap[ event_count ];
+      event_sift_down( 0 );
     }
+    event_update_next_event();
 
     if( descriptor.fn ) descriptor.fn( ptr->tstates, ptr->type, ptr->user_data );
 
-    if( event_free ) {
-      libspectrum_free( ptr );
-    } else {
-      event_free = ptr;
-    }
+    event_release( ptr );
   }
 
   return 0;
 }
 
-static void
-event_reduce_tstates( gpointer data, gpointer user_data )
-{
-  event_t *ptr = data;
-  libspectrum_dword *tstates_per_frame = user_data;
-
-  ptr->tstates -= *tstates_per_frame;
-}
-
 /* Called at end of frame to reduce T-state count of all entries */
 void
 event_frame( libspectrum_dword tstates_per_frame )
 {
-  g_slist_foreach( event_list, event_reduce_tstates, &tstates_per_frame );
+  size_t i;
 
-  event_next_event = event_list ?
-    ((event_t*)(event_list->data))->tstates : event_no_events;
+  /* All events move by the same amount, so the heap stays valid */
+  for( i = 0; i < event_count; i++ )
+    event_heap[i]->tstates -= tstates_per_frame;
+
+  event_update_next_event();
 }
 
 /* Do all events that would happen between the current time and when
@@ -183,69 +248,84 @@ event_force_events( void )
   }
 }
 
+/* Remove all events of type `type' (and with user data `user_data' if
+   `match_user_data' is set) from the heap */
 static void
-set_event_null( gpointer data, gpointer user_data )
+event_remove_matching( int type, int match_user_data, gpointer user_data )
 {
-  event_t *ptr = data;
-  int *type = user_data;
+  size_t i, kept = 0;
 
-  if( ptr->type == *type ) ptr->type = event_type_null;
-}
+  for( i = 0; i < event_count; i++ ) {
+    event_t *ptr = event_heap[i];
 
-static void
-set_event_null_with_user_data( gpointer data, gpointer user_data )
-{
-  event_t *event = data;
-  event_t *template = user_data;
+    if( ptr->type == type &&
+        ( !match_user_data || ptr->user_data == user_data ) ) {
+      event_release( ptr );
+    } else {
+      event_heap[ kept++ ] = ptr;
+    }
+  }
+
+  if( kept == event_count ) return;
 
-  if( event->type == template->type && event->user_data == template->user_data )
-    event->type = event_type_null;
+  event_count = kept;
+  event_heapify();
+  event_update_next_event();
 }
 
 /* Remove all events of a specific type from the stack */
 void
 event_remove_type( int type )
 {
-  g_slist_foreach( event_list, set_event_null, &type );
+  event_remove_matching( type, 0, NULL );
 }
 
 /* Remove all events of a specific type and user data from the stack */
 void
 event_remove_type_user_data( int type, gpointer user_data )
 {
-  event_t template;
-
-  template.type = type;
-  template.user_data = user_data;
-  g_slist_foreach( event_list, set_event_null_with_user_data, &template );
-}
-
-/* Free the memory used by a specific entry */
-static void
-event_free_entry( gpointer data, gpointer user_data GCC_UNUSED )
-{
-  libspectrum_free( data );
+  event_remove_matching( type, 1, user_data );
 }
 
 /* Clear the event stack */
 void
 event_reset( void )
 {
-  g_slist_foreach( event_list, event_free_entry, NULL );
-  g_slist_free( event_list );
-  event_list = NULL;
+  size_t i;
+
+  for( i = 0; i < event_count; i++ ) libspectrum_free( event_heap[i] );
+  event_count = 0;
 
   event_next_event = event_no_events;
 
-  libspectrum_free( event_free );
-  event_free = NULL;
+  while( event_free ) {
+    event_t *next = event_free->next_free;
+    libspectrum_free( event_free );
+    event_free = next;
+  }
 }
 
 /* Call a user-supplied function for every event in the current list */
 void
 event_foreach( GFunc function, gpointer user_data )
 {
-  g_slist_foreach( event_list, function, user_data );
+  event_t **sorted;
+  size_t i, count = event_count;
+
+  if( !count ) return;
+
+  /* Call the function in time order, as callers expect */
+  sorted = libspectrum_new( event_t*, count );
+  memcpy( sorted, event_heap, count * sizeof( *sorted ) );
+  qsort( sorted, count, sizeof( *sorted ), event_compare );
+
+  for( i = 0; i < count; i++ ) function( sorted[i], user_data );
+
+  libspectrum_free( sorted );
+
+  /* The function may have changed the type of some events */
+  event_heapify();
+  event_update_next_event();
 }
 
 /* A textual representation of each event type */
@@ -277,6 +357,9 @@ static void
 event_end( void )
 {
   event_reset();
+  libspectrum_free( event_heap );
+  event_heap = NULL;
+  event_heap_size = 0;
   registered_events_free();
 }
 
@@ -35,6 +35,12 @@ typedef struct event_t {
   libspectrum_dword tstates;
   int type;
   void *user_data;
+
+  /* Private to event.c: the order in which events were added, used to
+     keep events with the same time and type in FIFO order, and the link
+     for the list of unused events */
+  libspectrum_dword sequence;
+  struct event_t *next_free;
 } event_t;
 
 /* A null event type */
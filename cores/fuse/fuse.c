@@ -53,6 +53,7 @@
 #include <libxml/encoding.h>
 #endif
 
+#include "benchmark.h"
 #include "debugger/debugger.h"
 #include "display.h"
 #include "event.h"
@@ -199,6 +200,15 @@ int main(int argc, char **argv)
 
   if( settings_current.unittests ) {
     r = unittests_run();
+#ifdef UI_NULL
+  } else if( settings_current.benchmark > 0 ) {
+    r = benchmark_run();
+#else				/* #ifdef UI_NULL */
+  } else if( settings_current.benchmark > 0 ) {
+    fprintf( stderr, "%s: benchmarking needs the null user interface\n",
+             fuse_progname );
+    r = 1;
+#endif				/* #ifdef UI_NULL */
   } else {
     while( !fuse_exiting ) {
       z80_do_opcodes();
@@ -23,6 +23,7 @@
 
 #include <config.h>
 
+#include <stdio.h>
 #include <string.h>
 
 #include <libspectrum.h>
@@ -36,6 +37,17 @@ libspectrum_byte pokefinder_possible[ MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES ]
 libspectrum_byte pokefinder_impossible[ MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES ][ MEMORY_PAGE_SIZE / 8 ];
 size_t pokefinder_count;
 
+/* The number of possible locations left in each page, so that pages with
+   none can be skipped without looking at their bitmaps */
+static size_t page_count[ MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES ];
+
+typedef enum pokefinder_test {
+  POKEFINDER_TEST_EQUAL,
+  POKEFINDER_TEST_INCREMENTED,
+  POKEFINDER_TEST_DECREMENTED,
+  POKEFINDER_TEST_CHANGED_BY,
+} pokefinder_test;
+
 void
 pokefinder_clear( void )
 {
@@ -46,77 +58,294 @@ pokefinder_clear( void )
   for( page = 0; page < MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES; ++page )
     if( page < max_page && memory_map_ram[page].writable ) {
       pokefinder_count += MEMORY_PAGE_SIZE;
+      page_count[page] = MEMORY_PAGE_SIZE;
       memcpy( pokefinder_possible[page], memory_map_ram[page].page, MEMORY_PAGE_SIZE );
       memset( pokefinder_impossible[page], 0, MEMORY_PAGE_SIZE / 8 );
-    } else
+    } else {
+      page_count[page] = 0;
       memset( pokefinder_impossible[page], 255, MEMORY_PAGE_SIZE / 8 );
+    }
 }
 
-int
-pokefinder_search( libspectrum_byte value )
+/* The number of bits set in each nibble */
+static const libspectrum_byte nibble_bits[16] = {
+  0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+};
+
+/* Pages with more possible locations than this are compared in full;
+   sparser pages are compared only where locations remain */
+#define DENSE_PAGE_THRESHOLD ( MEMORY_PAGE_SIZE / 8 )
+
+/* Multiplying eight flags of 0 or 1 loaded as a qword by this moves
+   flag n into bit 56 + n without any carries */
+#ifdef WORDS_BIGENDIAN
+#define PACK_MULTIPLIER ( (libspectrum_qword)0x80402010 << 32 | 0x08040201 )
+#else				/* #ifdef WORDS_BIGENDIAN */
+#define PACK_MULTIPLIER ( (libspectrum_qword)0x01020408 << 32 | 0x10204080 )
+#endif				/* #ifdef WORDS_BIGENDIAN */
+
+/* Set `flags' to 1 for each of `length' locations for which `test' fails
+   and 0 for the rest. The switch is outside the loops, leaving each one
+   branch free so that the compiler can vectorise it */
+static void
+compare( pokefinder_test test, const libspectrum_byte *current,
+         const libspectrum_byte *previous, libspectrum_byte value,
+         libspectrum_byte *flags, size_t length )
 {
-  size_t page, offset;
+  size_t i;
+
+  switch( test ) {
+
+  case POKEFINDER_TEST_EQUAL:
+    for( i = 0; i < length; i++ )
+      flags[i] = current[i] != value;
+    break;
+
+  case POKEFINDER_TEST_INCREMENTED:
+    for( i = 0; i < length; i++ )
+      flags[i] = current[i] <= previous[i];
+    break;
+
+  case POKEFINDER_TEST_DECREMENTED:
+    for( i = 0; i < length; i++ )
+      flags[i] = current[i] >= previous[i];
+    break;
+
+  case POKEFINDER_TEST_CHANGED_BY:
+    for( i = 0; i < length; i++ )
+      flags[i] = (libspectrum_byte)( current[i] - previous[i] ) != value;
+    break;
+
+  }
+}
+
+/* Pack eight flags into one byte of the impossible bitmap */
+static libspectrum_byte
+pack_flags( const libspectrum_byte *flags )
+{
+  libspectrum_qword packed;
+
+  memcpy( &packed, flags, sizeof( packed ) );
+
+  return ( packed * PACK_MULTIPLIER ) >> 56;
+}
+
+/* Mark the locations in `failed' as impossible, returning how many of
+   them were previously possible */
+static size_t
+remove_group( libspectrum_byte *impossible, libspectrum_byte failed )
+{
+  failed &= ~*impossible;
+  *impossible |= failed;
+
+  return nibble_bits[ failed & 0x0f ] + nibble_bits[ failed >> 4 ];
+}
+
+/* Remove every possible location for which `test' fails, and remember
+   the current value of the others for the next comparison. Dense pages
+   are compared in full; in sparse pages, only groups of locations where
+   some remain possible are compared, and pages with none are skipped */
+static void
+narrow( pokefinder_test test, libspectrum_byte value )
+{
+  libspectrum_byte flags[ MEMORY_PAGE_SIZE ];
+  size_t page, i, removed;
 
   for( page = 0; page < MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES; page++ ) {
-    memory_page *mapping = &memory_map_ram[ page ];
+    const libspectrum_byte *current = memory_map_ram[page].page;
+    libspectrum_byte *previous = pokefinder_possible[page];
+    libspectrum_byte *impossible = pokefinder_impossible[page];
 
-    for( offset = 0; offset < MEMORY_PAGE_SIZE; offset++ ) {
-      if( pokefinder_impossible[page][offset/8] & 1 << (offset & 7) ) continue;
+    if( !page_count[page] ) continue;
+
+    removed = 0;
+
+    if( page_count[page] > DENSE_PAGE_THRESHOLD ) {
 
-      if( mapping->page[offset] != value ) {
-	pokefinder_impossible[page][offset/8] |= 1 << (offset & 7);
-	pokefinder_count--;
+      compare( test, current, previous, value, flags, MEMORY_PAGE_SIZE );
+      if( test != POKEFINDER_TEST_EQUAL )
+        memcpy( previous, current, MEMORY_PAGE_SIZE );
+
+      for( i = 0; i < MEMORY_PAGE_SIZE; i += 8 )
+        removed += remove_group( &impossible[ i / 8 ], pack_flags( &flags[i] ) );
+
+    } else {
+
+      for( i = 0; i < MEMORY_PAGE_SIZE; i += 8 ) {
+        if( impossible[ i / 8 ] == 0xff ) continue;
+
+        compare( test, &current[i], &previous[i], value, flags, 8 );
+        if( test != POKEFINDER_TEST_EQUAL )
+          memcpy( &previous[i], &current[i], 8 );
+
+        removed += remove_group( &impossible[ i / 8 ], pack_flags( flags ) );
       }
+
     }
+
+    pokefinder_count -= removed;
+    page_count[page] -= removed;
   }
+}
+
+int
+pokefinder_search( libspectrum_byte value )
+{
+  narrow( POKEFINDER_TEST_EQUAL, value );
 
   return 0;
 }
 
 int
 pokefinder_incremented( void )
+{
+  narrow( POKEFINDER_TEST_INCREMENTED, 0 );
+
+  return 0;
+}
+
+int
+pokefinder_decremented( void )
+{
+  narrow( POKEFINDER_TEST_DECREMENTED, 0 );
+
+  return 0;
+}
+
+/* Keep only locations whose value has changed by exactly `delta' (modulo
+   256) since the last comparison */
+int
+pokefinder_changed_by( int delta )
+{
+  narrow( POKEFINDER_TEST_CHANGED_BY, delta & 0xff );
+
+  return 0;
+}
+
+static libspectrum_dword unittest_seed;
+
+static libspectrum_byte
+unittest_random( void )
+{
+  unittest_seed = unittest_seed * 1103515245 + 12345;
+  return unittest_seed >> 16;
+}
+
+static int
+unittest_page_valid( size_t page )
+{
+  return page < MEMORY_PAGES_IN_16K * machine_current->ram.valid_pages &&
+         memory_map_ram[page].writable;
+}
+
+/* Change every byte of RAM by between -2 and +2 */
+static void
+unittest_mutate( void )
 {
   size_t page, offset;
 
   for( page = 0; page < MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES; page++ ) {
-    memory_page *mapping = &memory_map_ram[ page ];
+    if( !unittest_page_valid( page ) ) continue;
+    for( offset = 0; offset < MEMORY_PAGE_SIZE; offset++ )
+      memory_map_ram[page].page[offset] += unittest_random() % 5 - 2;
+  }
+}
+
+/* Check one search against a location by location reference */
+static int
+unittest_narrow( pokefinder_test test, int value )
+{
+  static libspectrum_byte
+    expected[ MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES ][ MEMORY_PAGE_SIZE / 8 ];
+  size_t page, offset, expected_count = 0;
+
+  memcpy( expected, pokefinder_impossible, sizeof( expected ) );
 
+  for( page = 0; page < MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES; page++ ) {
     for( offset = 0; offset < MEMORY_PAGE_SIZE; offset++ ) {
-      if( pokefinder_impossible[page][offset/8] & 1 << (offset & 7) ) continue;
+      libspectrum_byte current, previous;
+      int passes = 0;
 
-      if( mapping->page[offset] > pokefinder_possible[page][offset] ) {
-        pokefinder_possible[page][offset] = mapping->page[offset];
-      } else {
-	pokefinder_impossible[page][offset/8] |= 1 << (offset & 7);
-	pokefinder_count--;
+      if( expected[page][offset/8] & 1 << (offset & 7) ) continue;
+
+      current = memory_map_ram[page].page[offset];
+      previous = pokefinder_possible[page][offset];
+
+      switch( test ) {
+      case POKEFINDER_TEST_EQUAL: passes = current == value; break;
+      case POKEFINDER_TEST_INCREMENTED: passes = current > previous; break;
+      case POKEFINDER_TEST_DECREMENTED: passes = current < previous; break;
+      case POKEFINDER_TEST_CHANGED_BY:
+        passes = ( ( current - previous ) & 0xff ) == ( value & 0xff );
+        break;
       }
 
+      if( passes ) {
+        expected_count++;
+      } else {
+        expected[page][offset/8] |= 1 << (offset & 7);
+      }
     }
   }
 
+  switch( test ) {
+  case POKEFINDER_TEST_EQUAL: pokefinder_search( value ); break;
+  case POKEFINDER_TEST_INCREMENTED: pokefinder_incremented(); break;
+  case POKEFINDER_TEST_DECREMENTED: pokefinder_decremented(); break;
+  case POKEFINDER_TEST_CHANGED_BY: pokefinder_changed_by( value ); break;
+  }
+
+  if( pokefinder_count != expected_count ) {
+    printf( "%s:%d: test %d found %lu locations, expected %lu\n", __FILE__,
+            __LINE__, test, (unsigned long)pokefinder_count,
+            (unsigned long)expected_count );
+    return 1;
+  }
+
+  if( memcmp( expected, pokefinder_impossible, sizeof( expected ) ) ) {
+    printf( "%s:%d: test %d found the wrong locations\n", __FILE__, __LINE__,
+            test );
+    return 1;
+  }
+
   return 0;
 }
 
 int
-pokefinder_decremented( void )
+pokefinder_unittest( void )
 {
-  size_t page, offset;
+  size_t page, offset, expected_count = 0;
+  int r = 0;
 
-  for( page = 0; page < MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES; page++ ) {
-    memory_page *mapping = &memory_map_ram[ page ];
+  unittest_seed = 1;
 
-    for( offset = 0; offset < MEMORY_PAGE_SIZE; offset++ ) {
-      if( pokefinder_impossible[page][offset/8] & 1 << (offset & 7) ) continue;
+  for( page = 0; page < MEMORY_PAGES_IN_16K * SPECTRUM_RAM_PAGES; page++ ) {
+    if( !unittest_page_valid( page ) ) continue;
+    for( offset = 0; offset < MEMORY_PAGE_SIZE; offset++ )
+      memory_map_ram[page].page[offset] = unittest_random();
+    expected_count += MEMORY_PAGE_SIZE;
+  }
 
-      if( mapping->page[offset] < pokefinder_possible[page][offset] ) {
-        pokefinder_possible[page][offset] = mapping->page[offset];
-      } else {
-	pokefinder_impossible[page][offset/8] |= 1 << (offset & 7);
-	pokefinder_count--;
-      }
+  pokefinder_clear();
 
-    }
+  if( pokefinder_count != expected_count ) {
+    printf( "%s:%d: %lu locations after clear, expected %lu\n", __FILE__,
+            __LINE__, (unsigned long)pokefinder_count,
+            (unsigned long)expected_count );
+    return 1;
   }
 
-  return 0;
+  unittest_mutate();
+  r += unittest_narrow( POKEFINDER_TEST_INCREMENTED, 0 );
+  unittest_mutate();
+  r += unittest_narrow( POKEFINDER_TEST_DECREMENTED, 0 );
+  unittest_mutate();
+  r += unittest_narrow( POKEFINDER_TEST_CHANGED_BY, 1 );
+  unittest_mutate();
+  r += unittest_narrow( POKEFINDER_TEST_CHANGED_BY, -2 );
+  r += unittest_narrow( POKEFINDER_TEST_EQUAL, 0x42 );
+
+  pokefinder_clear();
+
+  return r;
 }
@@ -34,5 +34,8 @@ void pokefinder_clear( void );
 int pokefinder_search( libspectrum_byte value );
 int pokefinder_incremented( void );
 int pokefinder_decremented( void );
+int pokefinder_changed_by( int delta );
+
+int pokefinder_unittest( void );
 
 #endif				/* #ifndef FUSE_POKEFINDER_H */
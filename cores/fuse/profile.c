@@ -23,6 +23,7 @@
 
 #include <config.h>
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -32,20 +33,48 @@
 #include "infrastructure/startup_manager.h"
 #include "module.h"
 #include "profile.h"
+#include "settings.h"
 #include "ui/ui.h"
 #include "z80/z80.h"
 
+/* Is the per-instruction profiler running? */
 int profile_active = 0;
 
+/* Is the sampling profiler running? */
+int profile_sampling = 0;
+
 static int total_tstates[ 0x10000 ];
 static libspectrum_word profile_last_pc;
 static libspectrum_dword profile_last_tstates;
 
+/* The deepest call stack tracked by the sampling profiler; any calls
+   nested more deeply are charged to the innermost tracked function */
+#define PROFILE_STACK_DEPTH 64
+
+typedef struct profile_stack_frame {
+  libspectrum_word sp;		/* SP once the return address was pushed */
+  libspectrum_word function;	/* The address called */
+} profile_stack_frame;
+
+static profile_stack_frame call_stack[ PROFILE_STACK_DEPTH ];
+static size_t call_stack_depth;
+
+static libspectrum_dword sample_interval;
+static int sample_event;
+
+/* Number of samples taken for each call stack. Stacks are stored as the
+   number of addresses, then the functions called from outermost to
+   innermost, then PC */
+static GHashTable *samples;
+
+static void profile_reset( int hard_reset GCC_UNUSED );
 static void profile_from_snapshot( libspectrum_snap *snap GCC_UNUSED );
+static void profile_sample( libspectrum_dword last_tstates, int type,
+                            void *user_data );
 
 static module_info_t profile_module_info = {
 
-  NULL,
+  profile_reset,
   NULL,
   NULL,
   profile_from_snapshot,
@@ -58,13 +87,18 @@ profile_init( void *context )
 {
   module_register( &profile_module_info );
 
+  sample_event = event_register( profile_sample, "Profiler sample" );
+
   return 0;
 }
 
 void
 profile_register_startup( void )
 {
-  startup_manager_module dependencies[] = { STARTUP_MANAGER_MODULE_SETUID };
+  startup_manager_module dependencies[] = {
+    STARTUP_MANAGER_MODULE_EVENT,
+    STARTUP_MANAGER_MODULE_SETUID,
+  };
   startup_manager_register( STARTUP_MANAGER_MODULE_PROFILE, dependencies,
                             ARRAY_SIZE( dependencies ), profile_init, NULL,
                             NULL );
@@ -77,13 +111,52 @@ init_profiling_counters( void )
   profile_last_tstates = tstates;
 }
 
+static guint
+stack_hash( gconstpointer key )
+{
+  const libspectrum_word *stack = key;
+  guint hash = 0;
+  size_t i;
+
+  for( i = 0; i <= stack[0]; i++ ) hash = hash * 31 + stack[i];
+
+  return hash;
+}
+
+static gboolean
+stack_equal( gconstpointer a, gconstpointer b )
+{
+  const libspectrum_word *stack_a = a, *stack_b = b;
+
+  return stack_a[0] == stack_b[0] &&
+         !memcmp( stack_a, stack_b, ( stack_a[0] + 1 ) * sizeof( *stack_a ) );
+}
+
+/* Start sampling afresh from the current point of execution */
+static void
+init_sampling( void )
+{
+  call_stack_depth = 0;
+
+  event_remove_type( sample_event );
+  event_add( tstates + sample_interval, sample_event );
+}
+
 void
 profile_start( void )
 {
-  memset( total_tstates, 0, sizeof( total_tstates ) );
-
-  profile_active = 1;
-  init_profiling_counters();
+  if( settings_current.profile_interval > 0 ) {
+    sample_interval = settings_current.profile_interval;
+    samples = g_hash_table_new_full( stack_hash, stack_equal, libspectrum_free,
+                                     libspectrum_free );
+    profile_sampling = 1;
+    init_sampling();
+  } else {
+    memset( total_tstates, 0, sizeof( total_tstates ) );
+
+    profile_active = 1;
+    init_profiling_counters();
+  }
 
   /* Schedule an event to ensure that the main z80 emulation loop recognises
      profiling is turned on; otherwise problems occur if we started while
@@ -108,12 +181,98 @@ profile_frame( libspectrum_dword frame_length )
   profile_last_tstates -= frame_length;
 }
 
+/* Drop any calls whose return address is no longer on the stack, either
+   because they have returned or because the stack has been unwound by
+   other means; `limit' is the lowest SP at which a call is still live */
+static void
+call_stack_unwind( libspectrum_dword limit )
+{
+  while( call_stack_depth && call_stack[ call_stack_depth - 1 ].sp < limit )
+    call_stack_depth--;
+}
+
+/* Called by CALL, RST and interrupts after the return address has been
+   pushed and PC set to `function' */
+void
+profile_call( libspectrum_word function )
+{
+  /* Any tracked call whose return address was stored at or below SP has
+     since returned, or had its return address overwritten by this push */
+  call_stack_unwind( (libspectrum_dword)z80.sp.w + 1 );
+
+  if( call_stack_depth == PROFILE_STACK_DEPTH ) return;
+
+  call_stack[ call_stack_depth ].sp = z80.sp.w;
+  call_stack[ call_stack_depth ].function = function;
+  call_stack_depth++;
+}
+
+/* Called by the RET family after the return address has been popped */
+void
+profile_return( void )
+{
+  call_stack_unwind( z80.sp.w );
+}
+
+static void
+profile_sample( libspectrum_dword last_tstates, int type GCC_UNUSED,
+                void *user_data GCC_UNUSED )
+{
+  libspectrum_word stack[ PROFILE_STACK_DEPTH + 2 ];
+  libspectrum_dword *count, due;
+  size_t i;
+
+  call_stack_unwind( z80.sp.w );
+
+  stack[0] = call_stack_depth + 1;
+  for( i = 0; i < call_stack_depth; i++ )
+    stack[ i + 1 ] = call_stack[i].function;
+  stack[ call_stack_depth + 1 ] = z80.pc.w;
+
+  count = g_hash_table_lookup( samples, stack );
+  if( !count ) {
+    libspectrum_word *key = libspectrum_new( libspectrum_word, stack[0] + 1 );
+    memcpy( key, stack, ( stack[0] + 1 ) * sizeof( *key ) );
+    count = libspectrum_new0( libspectrum_dword, 1 );
+    g_hash_table_insert( samples, key, count );
+  }
+  /* A long instruction may have carried us past more than one sample
+     point; charge all of them to this sample */
+  due = ( tstates - last_tstates ) / sample_interval + 1;
+  *count += due;
+
+  event_add( last_tstates + due * sample_interval, sample_event );
+}
+
+/* The event stack is cleared when the machine is changed, so restart
+   sampling on reset */
+static void
+profile_reset( int hard_reset GCC_UNUSED )
+{
+  if( profile_sampling ) init_sampling();
+}
+
 /* On snapshot load, PC and the tstate counter will jump so reset our
    current views of these */
 static void
 profile_from_snapshot( libspectrum_snap *snap GCC_UNUSED )
 {
   init_profiling_counters();
+  if( profile_sampling ) init_sampling();
+}
+
+static void
+write_sample( gpointer key, gpointer value, gpointer user_data )
+{
+  const libspectrum_word *stack = key;
+  libspectrum_dword *count = value;
+  FILE *f = user_data;
+  size_t i;
+
+  for( i = 1; i <= stack[0]; i++ )
+    fprintf( f, "%s0x%04x", i > 1 ? ";" : "", stack[i] );
+
+  fprintf( f, " %lu\n", (unsigned long)( *count ) * sample_interval );
 }
 
 void
@@ -129,17 +288,31 @@ profile_finish( const char *filename )
     return;
   }
 
-  for( i = 0; i < 0x10000; i++ ) {
+  if( profile_sampling ) {
+
+    /* One line per call stack in the "folded" format used by flame graph
+       tools, weighted by the T-states each sample represents */
+    g_hash_table_foreach( samples, write_sample, f );
+
+    event_remove_type( sample_event );
+    g_hash_table_destroy( samples ); samples = NULL;
+
+  } else {
+
+    for( i = 0; i < 0x10000; i++ ) {
+
+      if( !total_tstates[ i ] ) continue;
 
-    if( !total_tstates[ i ] ) continue;
+      fprintf( f, "0x%04lx,%d\n", (unsigned long)i, total_tstates[ i ] );
 
-    fprintf( f, "0x%04lx,%d\n", (unsigned long)i, total_tstates[ i ] );
+    }
 
   }
 
   fclose( f );
 
   profile_active = 0;
+  profile_sampling = 0;
 
   /* Again, schedule an event to ensure this change is picked up by
      the main loop */
@@ -25,10 +25,13 @@
 #define FUSE_PROFILE_H
 
 extern int profile_active;
+extern int profile_sampling;
 
 void profile_register_startup( void );
 void profile_start( void );
 void profile_map( libspectrum_word pc );
+void profile_call( libspectrum_word function );
+void profile_return( void );
 void profile_frame( libspectrum_dword frame_length );
 void profile_finish( const char *filename );
 
@@ -35,6 +35,7 @@ typedef struct settings_info {
    int aspect_hint;
    int auto_load;
    int autosave_settings;
+   int benchmark;
    int beta128;
    int beta128_48boot;
   char *betadisk_file;
@@ -163,6 +164,7 @@ typedef struct settings_info {
    int printer;
   char *printer_graphics_filename;
   char *printer_text_filename;
+   int profile_interval;
    int raw_s_net;
   char *record_file;
    int recreated_spectrum;
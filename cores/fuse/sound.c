@@ -28,6 +28,10 @@
 
 #include <config.h>
 
+#include <stdio.h>
+#include <string.h>
+
+#include "benchmark.h"
 #include "fuse.h"
 #include "infrastructure/startup_manager.h"
 #include "machine.h"
@@ -47,6 +51,8 @@ int sound_enabled = 0;		/* Are we currently using the sound card */
 
 static int sound_enabled_ever = 0; /* whether sound has *ever* been in use; see
 				      sound_ay_write() and sound_ay_reset() */
+static int sound_device_open = 0; /* has sound_lowlevel_init() succeeded? Not
+				     the case when benchmarking */
 int sound_stereo_ay = SOUND_STEREO_AY_NONE; /* local copy of settings_current.stereo_ay */
 
 /* assume all three tone channels together match the beeper volume (ish).
@@ -70,9 +76,14 @@ static int sound_channels;
 static unsigned int ay_tone_levels[16];
 
 static unsigned int ay_tone_tick[3], ay_tone_high[3], ay_noise_tick;
-static unsigned int ay_tone_cycles, ay_env_cycles;
 static unsigned int ay_env_internal_tick, ay_env_tick;
 static unsigned int ay_tone_period[3], ay_noise_period, ay_env_period;
+static int ay_rng = 1, ay_noise_toggle = 0;
+static int ay_env_first = 1, ay_env_rev = 0, ay_env_counter = 15;
+
+/* Whether sound_ay_render() skips over ticks with no output changes; only
+   turned off by the unit tests to compare against stepping every tick */
+static int ay_fast_forward = 1;
 
 /* Local copy of the AY registers */
 static libspectrum_byte sound_ay_registers[16];
@@ -172,7 +183,6 @@ sound_ay_init( void )
 
   ay_noise_tick = ay_noise_period = 0;
   ay_env_internal_tick = ay_env_tick = ay_env_period = 0;
-  ay_tone_cycles = ay_env_cycles = 0;
   for( f = 0; f < 3; f++ )
     ay_tone_tick[f] = ay_tone_high[f] = 0, ay_tone_period[f] = 1;
 
@@ -217,10 +227,13 @@ sound_init( const char *device )
   /* only try for stereo if we need it */
   sound_stereo_ay = option_enumerate_sound_stereo_ay();
 
-  if( settings_current.sound &&
-      sound_lowlevel_init( device, &settings_current.sound_freq,
-                           &sound_stereo_ay ) )
-    return;
+  /* Benchmarks generate sound without playing it */
+  if( settings_current.benchmark <= 0 ) {
+    if( sound_lowlevel_init( device, &settings_current.sound_freq,
+                             &sound_stereo_ay ) )
+      return;
+    sound_device_open = 1;
+  }
 
   if( !sound_init_blip(&left_buf, &left_beeper_synth) ) return;
   if( sound_stereo_ay != SOUND_STEREO_AY_NONE &&
@@ -371,8 +384,10 @@ sound_end( void )
     delete_Blip_Buffer( &left_buf );
     delete_Blip_Buffer( &right_buf );
 
-    //if( settings_current.sound ) /* On shutdown, we're called after settings_current is reset.
-      sound_lowlevel_end();
+    /* On shutdown, we're called after settings_current is reset, so
+       check whether the device was opened rather than the setting */
+    if( sound_device_open ) sound_lowlevel_end();
+    sound_device_open = 0;
     libspectrum_free( samples );
     sound_enabled = 0;
   }
@@ -420,14 +435,227 @@ ay_do_tone( int level, unsigned int tone_count, int *var, int chan )
    master clock by 2 to drive the AY */
 #define AY_CLOCK_RATIO 2
 
+/* the number of Spectrum tstates in one step of sound_ay_render(); each
+   step advances the tone counters by two and the noise and envelope
+   counters by one */
+#define AY_TICK_TSTATES ( AY_CLOCK_DIVISOR * AY_CLOCK_RATIO )
+#define AY_TONE_COUNT ( AY_CLOCK_DIVISOR / 8 )
+
+/* do a single 1/16th-of-period step of the envelope */
 static void
-sound_ay_overlay( void )
+ay_env_step( int envshape )
+{
+  /* do a 1/16th-of-period incr/decr if needed */
+  if( ay_env_first ||
+      ( ( envshape & AY_ENV_CONT ) && !( envshape & AY_ENV_HOLD ) ) ) {
+    if( ay_env_rev )
+      ay_env_counter -= ( envshape & AY_ENV_ATTACK ) ? 1 : -1;
+    else
+      ay_env_counter += ( envshape & AY_ENV_ATTACK ) ? 1 : -1;
+    if( ay_env_counter < 0 )
+      ay_env_counter = 0;
+    if( ay_env_counter > 15 )
+      ay_env_counter = 15;
+  }
+
+  ay_env_internal_tick++;
+  while( ay_env_internal_tick >= 16 ) {
+    ay_env_internal_tick -= 16;
+
+    /* end of cycle */
+    if( !( envshape & AY_ENV_CONT ) )
+      ay_env_counter = 0;
+    else {
+      if( envshape & AY_ENV_HOLD ) {
+        if( ay_env_first && ( envshape & AY_ENV_ALT ) )
+          ay_env_counter = ( ay_env_counter ? 0 : 15 );
+      } else {
+        /* non-hold */
+        if( envshape & AY_ENV_ALT )
+          ay_env_rev = !ay_env_rev;
+        else
+          ay_env_counter = ( envshape & AY_ENV_ATTACK ) ? 0 : 15;
+      }
+    }
+
+    ay_env_first = 0;
+  }
+}
+
+/* advance the envelope counter by `count' ticks; returns non-zero if the
+   envelope level changed */
+static int
+ay_env_advance( unsigned int count, int envshape )
+{
+  int old_counter = ay_env_counter;
+  unsigned int steps;
+
+  ay_env_tick += count;
+
+  /* a zero period steps the envelope once per tick */
+  if( ay_env_period ) {
+    steps = ay_env_tick / ay_env_period;
+    ay_env_tick %= ay_env_period;
+  } else {
+    steps = count;
+  }
+
+  /* once the first cycle is over, the envelope repeats every 32 steps */
+  while( steps && ay_env_first ) {
+    ay_env_step( envshape );
+    steps--;
+  }
+  steps %= 32;
+
+  while( steps-- )
+    ay_env_step( envshape );
+
+  return ay_env_counter != old_counter;
+}
+
+/* advance the noise counter by `count' ticks; returns non-zero if the
+   noise output changed */
+static int
+ay_noise_advance( unsigned int count )
+{
+  int old_toggle = ay_noise_toggle;
+  unsigned int steps;
+
+  ay_noise_tick += count;
+
+  /* a zero period clocks the RNG once per tick */
+  if( ay_noise_period ) {
+    steps = ay_noise_tick / ay_noise_period;
+    ay_noise_tick %= ay_noise_period;
+  } else {
+    steps = count;
+  }
+
+  while( steps-- ) {
+    if( ( ay_rng & 1 ) ^ ( ( ay_rng & 2 ) ? 1 : 0 ) )
+      ay_noise_toggle = !ay_noise_toggle;
+
+    /* rng is 17-bit shift reg, bit 0 is output.
+     * input is bit 0 xor bit 3.
+     */
+    if( ay_rng & 1 ) {
+      ay_rng ^= 0x24000;
+    }
+    ay_rng >>= 1;
+  }
+
+  return ay_noise_toggle != old_toggle;
+}
+
+/* Ticks until `period' is next reached by a counter at `tick' which
+   is advanced by one each tick */
+static unsigned int
+ay_ticks_to_period( unsigned int tick, unsigned int period )
+{
+  return tick < period ? period - tick : 1;
+}
+
+/* Work out how many ticks starting at `step' can be skipped without any
+   change in the output levels. Every edge of an audible tone, and any
+   noise or envelope step which can change what the next tick outputs,
+   must be handled by a full tick in sound_ay_render(). `env_changed' and
+   `noise_changed' say whether the previous tick changed those outputs */
+static unsigned int
+ay_idle_ticks( const struct ay_change_tag *change_ptr, int changes_left,
+               unsigned int step, unsigned int steps, int env_changed,
+               int noise_changed )
+{
+  unsigned int idle = steps - step, n;
+  int mixer = sound_ay_registers[7];
+  int envshape = sound_ay_registers[13];
+  int env_used = 0, noise_used = 0;
+  int g, volume;
+
+  if( changes_left ) {
+    n = ( change_ptr->tstates + AY_TICK_TSTATES - 1 ) / AY_TICK_TSTATES;
+    n = n > step ? n - step : 0;
+    if( n < idle ) idle = n;
+  }
+
+  for( g = 0; g < 3; g++ ) {
+    volume = sound_ay_registers[ 8 + g ] & 0x1f;
+
+    if( volume & 16 ) env_used = 1;
+    if( !( mixer & ( 0x08 << g ) ) ) noise_used = 1;
+
+    /* a disabled tone generator doesn't count at all */
+    if( mixer & ( 1 << g ) ) continue;
+
+    if( volume ) {
+      n = ay_tone_tick[g] + AY_TONE_COUNT >= ay_tone_period[g] ? 0 :
+          ( ay_tone_period[g] - ay_tone_tick[g] - 1 ) / AY_TONE_COUNT;
+    } else if( ay_tone_tick[g] >= ay_tone_period[g] ||
+               ay_tone_period[g] < AY_TONE_COUNT ) {
+      /* silent, but ay_skip() can't count the edges */
+      n = 0;
+    } else {
+      continue;
+    }
+
+    if( n < idle ) idle = n;
+  }
+
+  /* the noise and envelope are sampled before they are updated, so only
+     the tick after one of their steps sounds any different */
+  if( noise_used ) {
+    if( noise_changed )
+      n = 0;
+    else
+      n = ay_noise_period ?
+          ay_ticks_to_period( ay_noise_tick, ay_noise_period ) : 1;
+    if( n < idle ) idle = n;
+  }
+
+  /* once the first cycle is done, only a repeating envelope changes */
+  if( env_used ) {
+    if( env_changed )
+      n = 0;
+    else if( ay_env_first || ( ( envshape & AY_ENV_CONT ) &&
+                               !( envshape & AY_ENV_HOLD ) ) )
+      n = ay_env_period ?
+          ay_ticks_to_period( ay_env_tick, ay_env_period ) : 1;
+    else
+      n = idle;
+    if( n < idle ) idle = n;
+  }
+
+  return idle;
+}
+
+/* Advance all generators by `count' ticks during which no output level
+   changes */
+static void
+ay_skip( unsigned int count )
+{
+  int mixer = sound_ay_registers[7];
+  int g;
+
+  for( g = 0; g < 3; g++ ) {
+    if( mixer & ( 1 << g ) ) continue;
+
+    /* ay_idle_ticks() guarantees the tick is below the period, and the
+       period at least AY_TONE_COUNT, so at most one edge per tick */
+    ay_tone_tick[g] += count * AY_TONE_COUNT;
+    if( ay_tone_tick[g] >= ay_tone_period[g] ) {
+      ay_tone_high[g] ^= ( ay_tone_tick[g] / ay_tone_period[g] ) & 1;
+      ay_tone_tick[g] %= ay_tone_period[g];
+    }
+  }
+
+  ay_env_advance( count, sound_ay_registers[13] );
+  ay_noise_advance( count );
+}
+
+static void
+sound_ay_render( libspectrum_dword tstates_per_frame )
 {
-  static int rng = 1;
-  static int noise_toggle = 0;
-  static int env_first = 1, env_rev = 0, env_counter = 15;
   int tone_level[3];
-  int mixer, envshape;
+  int mixer;
   int g, level;
   libspectrum_dword f;
   struct ay_change_tag *change_ptr = ay_change;
@@ -435,16 +663,14 @@ sound_ay_overlay( void )
   int reg, r;
   int chan1, chan2, chan3;
   int last_chan1 = 0, last_chan2 = 0, last_chan3 = 0;
-  unsigned int tone_count, noise_count;
+  int env_changed, noise_changed;
+  unsigned int step, steps;
 
-  /* If no AY chip, don't produce any AY sound (!) */
-  if( !( periph_is_active( PERIPH_TYPE_FULLER) ||
-         periph_is_active( PERIPH_TYPE_MELODIK ) ||
-         machine_current->capabilities & LIBSPECTRUM_MACHINE_CAPABILITY_AY ) )
-    return;
+  steps = ( tstates_per_frame + AY_TICK_TSTATES - 1 ) / AY_TICK_TSTATES;
+
+  for( step = 0; step < steps; ) {
+    f = step * AY_TICK_TSTATES;
 
-  for( f = 0; f < machine_current->timings.tstates_per_frame;
-       f+= AY_CLOCK_DIVISOR * AY_CLOCK_RATIO ) {
     /* update ay registers. */
     while( changes_left && f >= change_ptr->tstates ) {
       sound_ay_registers[ reg = change_ptr->reg ] = change_ptr->val;
@@ -476,10 +702,10 @@ sound_ay_overlay( void )
           sound_ay_registers[11] | ( sound_ay_registers[12] << 8 );
         break;
       case 13:
-        ay_env_internal_tick = ay_env_tick = ay_env_cycles = 0;
-        env_first = 1;
-        env_rev = 0;
-        env_counter = ( sound_ay_registers[13] & AY_ENV_ATTACK ) ? 0 : 15;
+        ay_env_internal_tick = ay_env_tick = 0;
+        ay_env_first = 1;
+        ay_env_rev = 0;
+        ay_env_counter = ( sound_ay_registers[13] & AY_ENV_ATTACK ) ? 0 : 15;
         break;
       }
     }
@@ -489,64 +715,14 @@ sound_ay_overlay( void )
       tone_level[g] = ay_tone_levels[ sound_ay_registers[ 8 + g ] & 15 ];
 
     /* envelope */
-    envshape = sound_ay_registers[13];
-    level = ay_tone_levels[ env_counter ];
+    level = ay_tone_levels[ ay_env_counter ];
 
     for( g = 0; g < 3; g++ )
       if( sound_ay_registers[ 8 + g ] & 16 )
         tone_level[g] = level;
 
     /* envelope output counter gets incr'd every 16 AY cycles. */
-    ay_env_cycles += AY_CLOCK_DIVISOR;
-    noise_count = 0;
-    while( ay_env_cycles >= 16 ) {
-      ay_env_cycles -= 16;
-      noise_count++;
-      ay_env_tick++;
-      while( ay_env_tick >= ay_env_period ) {
-        ay_env_tick -= ay_env_period;
-
-        /* do a 1/16th-of-period incr/decr if needed */
-        if( env_first ||
-            ( ( envshape & AY_ENV_CONT ) && !( envshape & AY_ENV_HOLD ) ) ) {
-          if( env_rev )
-            env_counter -= ( envshape & AY_ENV_ATTACK ) ? 1 : -1;
-          else
-            env_counter += ( envshape & AY_ENV_ATTACK ) ? 1 : -1;
-          if( env_counter < 0 )
-            env_counter = 0;
-          if( env_counter > 15 )
-            env_counter = 15;
-        }
-
-        ay_env_internal_tick++;
-        while( ay_env_internal_tick >= 16 ) {
-          ay_env_internal_tick -= 16;
-
-          /* end of cycle */
-          if( !( envshape & AY_ENV_CONT ) )
-            env_counter = 0;
-          else {
-            if( envshape & AY_ENV_HOLD ) {
-              if( env_first && ( envshape & AY_ENV_ALT ) )
-                env_counter = ( env_counter ? 0 : 15 );
-            } else {
-              /* non-hold */
-              if( envshape & AY_ENV_ALT )
-                env_rev = !env_rev;
-              else
-                env_counter = ( envshape & AY_ENV_ATTACK ) ? 0 : 15;
-            }
-          }
-
-          env_first = 0;
-        }
-
-        /* don't keep trying if period is zero */
-        if( !ay_env_period )
-          break;
-      }
-    }
+    env_changed = ay_env_advance( 1, sound_ay_registers[13] );
 
     /* generate tone+noise... or neither.
      * (if no tone/noise is selected, the chip just shoves the
@@ -558,29 +734,25 @@ sound_ay_overlay( void )
     chan3 = tone_level[2];
     mixer = sound_ay_registers[7];
 
-    ay_tone_cycles += AY_CLOCK_DIVISOR;
-    tone_count = ay_tone_cycles >> 3;
-    ay_tone_cycles &= 7;
-
     if( ( mixer & 1 ) == 0 ) {
       level = chan1;
-      ay_do_tone( level, tone_count, &chan1, 0 );
+      ay_do_tone( level, AY_TONE_COUNT, &chan1, 0 );
     }
-    if( ( mixer & 0x08 ) == 0 && noise_toggle )
+    if( ( mixer & 0x08 ) == 0 && ay_noise_toggle )
       chan1 = 0;
 
     if( ( mixer & 2 ) == 0 ) {
       level = chan2;
-      ay_do_tone( level, tone_count, &chan2, 1 );
+      ay_do_tone( level, AY_TONE_COUNT, &chan2, 1 );
     }
-    if( ( mixer & 0x10 ) == 0 && noise_toggle )
+    if( ( mixer & 0x10 ) == 0 && ay_noise_toggle )
       chan2 = 0;
 
     if( ( mixer & 4 ) == 0 ) {
       level = chan3;
-      ay_do_tone( level, tone_count, &chan3, 2 );
+      ay_do_tone( level, AY_TONE_COUNT, &chan3, 2 );
     }
-    if( ( mixer & 0x20 ) == 0 && noise_toggle )
+    if( ( mixer & 0x20 ) == 0 && ay_noise_toggle )
       chan3 = 0;
 
     if( last_chan1 != chan1 ) {
@@ -600,28 +772,35 @@ sound_ay_overlay( void )
     }
 
     /* update noise RNG/filter */
-    ay_noise_tick += noise_count;
-    while( ay_noise_tick >= ay_noise_period ) {
-      ay_noise_tick -= ay_noise_period;
-
-      if( ( rng & 1 ) ^ ( ( rng & 2 ) ? 1 : 0 ) )
-        noise_toggle = !noise_toggle;
-
-      /* rng is 17-bit shift reg, bit 0 is output.
-       * input is bit 0 xor bit 3.
-       */
-      if( rng & 1 ) {
-        rng ^= 0x24000;
+    noise_changed = ay_noise_advance( 1 );
+
+    step++;
+
+    /* output only changes at tone, noise and envelope edges or register
+       writes, so jump straight to the next of those */
+    if( ay_fast_forward && step < steps ) {
+      unsigned int idle = ay_idle_ticks( change_ptr, changes_left, step,
+                                         steps, env_changed, noise_changed );
+      if( idle ) {
+        ay_skip( idle );
+        step += idle;
       }
-      rng >>= 1;
-
-      /* don't keep trying if period is zero */
-      if( !ay_noise_period )
-        break;
     }
   }
 }
 
+static void
+sound_ay_overlay( void )
+{
+  /* If no AY chip, don't produce any AY sound (!) */
+  if( !( periph_is_active( PERIPH_TYPE_FULLER) ||
+         periph_is_active( PERIPH_TYPE_MELODIK ) ||
+         machine_current->capabilities & LIBSPECTRUM_MACHINE_CAPABILITY_AY ) )
+    return;
+
+  sound_ay_render( machine_current->timings.tstates_per_frame );
+}
+
 /* don't make the change immediately; record it for later,
  * to be made by sound_frame() (via sound_ay_overlay()).
  */
@@ -652,7 +831,6 @@ sound_ay_reset( void )
     sound_ay_write( f, 0, 0 );
   for( f = 0; f < 3; f++ )
     ay_tone_high[f] = 0;
-  ay_tone_cycles = ay_env_cycles = 0;
 }
 
 /*
@@ -713,9 +891,13 @@ sound_frame( void )
     count = blip_buffer_read_samples( left_buf, samples, sound_framesiz, BLIP_BUFFER_DEF_STEREO );
   }
 
-  if( settings_current.sound ) 
+  if( settings_current.sound && sound_device_open )
     sound_lowlevel_frame( samples, count );
 
+#ifdef UI_NULL
+  if( benchmark_active ) benchmark_sound_frame( samples, count );
+#endif
+
   if( movie_recording )
       movie_add_sound( samples, count );
   ay_change_count = 0;
@@ -745,3 +927,115 @@ sound_beeper( libspectrum_dword at_tstates, int on )
   if( sound_stereo_ay != SOUND_STEREO_AY_NONE )
     blip_synth_update( right_beeper_synth, at_tstates, val );
 }
+
+/* Render a pseudo-random stream of AY register writes both with and
+   without fast-forwarding through idle ticks; the output must be
+   identical */
+int
+sound_ay_unittest( void )
+{
+  const libspectrum_dword frame_length = 70908;
+  const int frames = 50, max_samples = 1000;
+  Blip_Synth *saved_synths[6];
+  Blip_Buffer *buffer;
+  blip_sample_t *output[2];
+  long count[2];
+  libspectrum_dword seed, now;
+  int saved_rng = ay_rng, saved_noise_toggle = ay_noise_toggle;
+  int pass, frame, g, r = 0;
+
+  saved_synths[0] = ay_a_synth; saved_synths[1] = ay_b_synth;
+  saved_synths[2] = ay_c_synth; saved_synths[3] = ay_a_synth_r;
+  saved_synths[4] = ay_b_synth_r; saved_synths[5] = ay_c_synth_r;
+
+  buffer = new_Blip_Buffer();
+  blip_buffer_set_clock_rate( buffer, 3546900 );
+  if( blip_buffer_set_sample_rate( buffer, 44100, 1000 ) ) {
+    printf( "%s:%d: out of memory\n", __FILE__, __LINE__ );
+    delete_Blip_Buffer( &buffer );
+    return 1;
+  }
+
+  ay_a_synth_r = ay_b_synth_r = ay_c_synth_r = NULL;
+
+  for( pass = 0; pass < 2; pass++ ) {
+    /* fresh synths, as they remember the last level they were given */
+    ay_a_synth = new_Blip_Synth();
+    ay_b_synth = new_Blip_Synth();
+    ay_c_synth = new_Blip_Synth();
+    blip_synth_set_volume( ay_a_synth, 1.0 );
+    blip_synth_set_volume( ay_b_synth, 1.0 );
+    blip_synth_set_volume( ay_c_synth, 1.0 );
+    blip_synth_set_output( ay_a_synth, buffer );
+    blip_synth_set_output( ay_b_synth, buffer );
+    blip_synth_set_output( ay_c_synth, buffer );
+
+    output[ pass ] = libspectrum_new( blip_sample_t, frames * max_samples );
+    count[ pass ] = 0;
+
+    ay_fast_forward = pass;
+    blip_buffer_clear( buffer, 1 );
+    sound_ay_reset();
+
+    /* the noise generator isn't reset with the AY, so start both passes
+       from the same state */
+    ay_rng = 1;
+    ay_noise_toggle = 0;
+
+    seed = 1;
+    for( frame = 0; frame < frames; frame++ ) {
+      now = 0;
+
+      /* every fifth frame has no writes, leaving long idle stretches */
+      for( g = 0; frame % 5 && g < 24; g++ ) {
+        int reg, val;
+
+        seed = seed * 1103515245 + 12345;
+        now += ( seed >> 16 ) % ( frame_length / 24 );
+        reg = ( seed >> 8 ) % 14;
+        val = seed >> 24;
+
+        /* favour audible channels, and short tone, noise and envelope
+           periods which step several times a tick */
+        if( reg >= 8 && reg <= 10 && !( val & 0x1f ) ) val |= 0x0f;
+        if( ( seed & 0x10 ) && reg != 7 && reg < 13 ) val &= 3;
+
+        sound_ay_write( reg, val, now );
+      }
+
+      sound_ay_render( frame_length );
+      ay_change_count = 0;
+
+      blip_buffer_end_frame( buffer, frame_length );
+      count[ pass ] += blip_buffer_read_samples( buffer,
+                                                 output[ pass ] + count[ pass ],
+                                                 max_samples, 0 );
+    }
+
+    delete_Blip_Synth( &ay_a_synth );
+    delete_Blip_Synth( &ay_b_synth );
+    delete_Blip_Synth( &ay_c_synth );
+  }
+
+  if( count[0] != count[1] ||
+      memcmp( output[0], output[1], count[0] * sizeof( blip_sample_t ) ) ) {
+    printf( "%s:%d: AY output differs when skipping idle ticks\n", __FILE__,
+            __LINE__ );
+    r = 1;
+  }
+
+  libspectrum_free( output[0] );
+  libspectrum_free( output[1] );
+  delete_Blip_Buffer( &buffer );
+
+  ay_a_synth = saved_synths[0]; ay_b_synth = saved_synths[1];
+  ay_c_synth = saved_synths[2]; ay_a_synth_r = saved_synths[3];
+  ay_b_synth_r = saved_synths[4]; ay_c_synth_r = saved_synths[5];
+
+  ay_fast_forward = 1;
+  sound_ay_reset();
+  ay_rng = saved_rng;
+  ay_noise_toggle = saved_noise_toggle;
+
+  return r;
+}
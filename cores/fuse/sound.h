@@ -41,6 +41,8 @@ void sound_frame( void );
 void sound_beeper( libspectrum_dword at_tstates, int on );
 libspectrum_dword sound_get_effective_processor_speed( void );
 
+int sound_ay_unittest( void );
+
 extern int sound_enabled;
 extern int sound_framesiz;
 
@@ -25,6 +25,7 @@
 
 #include <libspectrum.h>
 
+#include "benchmark.h"
 #include "compat.h"
 #include "debugger/debugger.h"
 #include "display.h"
@@ -141,6 +142,10 @@ spectrum_frame( void )
 {
   libspectrum_dword frame_length;
 
+#ifdef UI_NULL
+  if( benchmark_active ) benchmark_lap( BENCHMARK_EMULATION );
+#endif
+
   /* Reduce the t-state count of both the processor and all the events
      scheduled to occur. Done slightly differently if RZX playback is
      occurring */
@@ -154,8 +159,14 @@ spectrum_frame( void )
     z80.interrupts_enabled_at -= frame_length;
 
   if( sound_enabled ) sound_frame();
+#ifdef UI_NULL
+  if( benchmark_active ) benchmark_lap( BENCHMARK_SOUND );
+#endif
 
   if( display_frame() ) return 1;
+#ifdef UI_NULL
+  if( benchmark_active ) benchmark_lap( BENCHMARK_DISPLAY );
+#endif
   if( profile_active ) profile_frame( frame_length );
   printer_frame();
 
@@ -169,6 +180,10 @@ spectrum_frame( void )
 
   frames_since_reset++;
 
+#ifdef UI_NULL
+  if( benchmark_active ) benchmark_frame( frame_length );
+#endif
+
   return 0;
 }
 
@@ -206,6 +206,13 @@ timer_frame( libspectrum_dword last_tstates, int event GCC_UNUSED,
   double current_time, difference;
   long tstates;
 
+  /* When benchmarking, run as fast as possible */
+  if( settings_current.benchmark > 0 ) {
+    event_add( last_tstates + machine_current->timings.tstates_per_frame,
+               timer_event );
+    return;
+  }
+
   if( sound_enabled && settings_current.sound ) {
     timer_frame_callback_sound( last_tstates );
     return;
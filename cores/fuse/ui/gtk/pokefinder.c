@@ -203,21 +203,30 @@ static void
 gtkui_pokefinder_search( GtkWidget *widget, gpointer user_data GCC_UNUSED )
 {
   long value;
-  const gchar *entry;
+  const gchar *entry, *digits;
   char *endptr;
   int base;
 
   errno = 0;
   entry = gtk_entry_get_text( GTK_ENTRY( widget ) );
-  base = ( g_str_has_prefix( entry, "0x" ) )? 16 : 10;
-  value = strtol( entry, &endptr, base );
 
-  if( errno != 0 || value < 0 || value > 255 || endptr == entry ) {
-    ui_error( UI_ERROR_ERROR, "Invalid value: use an integer from 0 to 255" );
+  /* A leading sign searches for locations changed by that amount */
+  digits = ( *entry == '+' || *entry == '-' ) ? entry + 1 : entry;
+
+  base = ( g_str_has_prefix( digits, "0x" ) )? 16 : 10;
+  value = strtol( digits, &endptr, base );
+
+  if( errno != 0 || value < 0 || value > 255 || endptr == digits ) {
+    ui_error( UI_ERROR_ERROR, "Invalid value: use an integer from 0 to 255, "
+              "optionally preceded by + or -" );
     return;
   }
 
-  pokefinder_search( value );
+  if( digits == entry ) {
+    pokefinder_search( value );
+  } else {
+    pokefinder_changed_by( *entry == '-' ? -value : value );
+  }
   update_pokefinder();
 }
 
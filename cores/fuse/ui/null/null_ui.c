@@ -23,6 +23,7 @@
 
 #include <config.h>
 
+#include "fuse.h"
 #include "keyboard.h"
 #include "ui/ui.h"
 
@@ -32,6 +33,14 @@ keysyms_map_t keysyms_map[] = {
   { 0, 0 } /* End marker */
 };
 
+/* The core is entered through fuse_main(), so provide main() here to give
+   the headless build an executable */
+int
+main( int argc, char **argv )
+{
+  return fuse_main( argc, argv );
+}
+
 scaler_type
 menu_get_scaler( scaler_available_fn selector )
 {
@@ -63,6 +63,8 @@ widget_pokefinder_draw( void *data )
   widget_printstring( 16, 88, WIDGET_COLOUR_FOREGROUND,
 		      "\x0AI\x01nc'd \x0A" "D\x01" "ec'd \x0AS\x01" "earch" );
   widget_printstring( 16, 96, WIDGET_COLOUR_FOREGROUND, "\x0AR\x01" "eset \x0A" "C\x01lose" );
+  widget_printstring( 16, 104, WIDGET_COLOUR_FOREGROUND,
+		      "\x0A+\x01/\x0A-\x01 Changed by value" );
 
   widget_display_lines( 2, 12 );
 
@@ -193,6 +195,15 @@ widget_pokefinder_keyhandler( input_key key )
     }
     break;
 
+  case INPUT_KEY_plus:		/* Search for changed by +value */
+  case INPUT_KEY_minus:		/* Search for changed by -value */
+    if( value < 256 ) {
+      pokefinder_changed_by( key == INPUT_KEY_minus ? -value : value );
+      update_possible();
+      display_possible();
+    }
+    break;
+
   case INPUT_KEY_r:		/* Reset */
     pokefinder_clear();
     update_possible();
@@ -289,7 +289,7 @@ static void
 win32ui_pokefinder_search( void )
 {
   long value;
-  TCHAR *buffer, *endptr;
+  TCHAR *buffer, *digits, *endptr;
   int buffer_size, base;
   HWND hwnd_control;
 
@@ -311,19 +311,28 @@ win32ui_pokefinder_search( void )
   }
 
   errno = 0;
-  base = ( !_tcsncmp( _T("0x"), buffer, strlen( _T("0x") ) ) )? 16 : 10;
-  value = _tcstol( buffer, &endptr, base );
 
-  if( errno || value < 0 || value > 255 || endptr == buffer ) {
+  /* A leading sign searches for locations changed by that amount */
+  digits = ( *buffer == '+' || *buffer == '-' ) ? buffer + 1 : buffer;
+
+  base = ( !_tcsncmp( _T("0x"), digits, strlen( _T("0x") ) ) )? 16 : 10;
+  value = _tcstol( digits, &endptr, base );
+
+  if( errno || value < 0 || value > 255 || endptr == digits ) {
     free( buffer );
-    ui_error( UI_ERROR_ERROR, "Invalid value: use an integer from 0 to 255" );
+    ui_error( UI_ERROR_ERROR, "Invalid value: use an integer from 0 to 255, "
+              "optionally preceded by + or -" );
     hwnd_control = GetDlgItem( fuse_hPFWnd, IDC_PF_EDIT );
     SendMessage( fuse_hPFWnd, WM_NEXTDLGCTL, (WPARAM) hwnd_control, TRUE );
     return;
   }
+  if( digits == buffer ) {
+    pokefinder_search( value );
+  } else {
+    pokefinder_changed_by( *buffer == '-' ? -value : value );
+  }
   free( buffer );
 
-  pokefinder_search( value );
   update_pokefinder();
 }
 
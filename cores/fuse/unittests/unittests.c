@@ -27,6 +27,7 @@
 #include <libspectrum.h>
 
 #include "debugger/debugger.h"
+#include "event.h"
 #include "fuse.h"
 #include "machine.h"
 #include "mempool.h"
@@ -46,7 +47,10 @@
 #include "peripherals/speccyboot.h"
 #include "peripherals/ula.h"
 #include "peripherals/usource.h"
+#include "pokefinder/pokefinder.h"
 #include "settings.h"
+#include "sound.h"
+#include "spectrum.h"
 #include "unittests.h"
 
 static int
@@ -308,6 +312,74 @@ mempool_test( void )
   return 0;
 }
 
+static int event_test_fired[8];
+static size_t event_test_count;
+
+static void
+event_test_fn( libspectrum_dword event_tstates, int type, void *user_data )
+{
+  if( event_test_count < ARRAY_SIZE( event_test_fired ) )
+    event_test_fired[ event_test_count ] = GPOINTER_TO_INT( user_data );
+  event_test_count++;
+}
+
+static int
+event_test( void )
+{
+  static int type1 = -1, type2 = -1;
+  libspectrum_dword old_tstates = tstates;
+
+  if( type1 == -1 ) {
+    type1 = event_register( event_test_fn, "Unit test event 1" );
+    type2 = event_register( event_test_fn, "Unit test event 2" );
+  }
+
+  event_reset();
+  event_test_count = 0;
+
+  /* Events fire in time order, then type order, then the order in which
+     they were added */
+  event_add_with_data( 100, type2, GINT_TO_POINTER( 1 ) );
+  event_add_with_data( 100, type1, GINT_TO_POINTER( 2 ) );
+  event_add_with_data(  50, type2, GINT_TO_POINTER( 3 ) );
+  event_add_with_data( 100, type1, GINT_TO_POINTER( 4 ) );
+  event_add_with_data( 200, type1, GINT_TO_POINTER( 5 ) );
+  event_add_with_data( 100, type1, GINT_TO_POINTER( 6 ) );
+  event_add_with_data( 150, type2, GINT_TO_POINTER( 7 ) );
+
+  TEST_ASSERT( event_next_event == 50 );
+
+  /* Removing events does not disturb the order of the others */
+  event_remove_type_user_data( type1, GINT_TO_POINTER( 4 ) );
+
+  tstates = 100;
+  event_do_events();
+
+  TEST_ASSERT( event_test_count == 4 );
+  TEST_ASSERT( event_test_fired[0] == 3 );
+  TEST_ASSERT( event_test_fired[1] == 2 );
+  TEST_ASSERT( event_test_fired[2] == 6 );
+  TEST_ASSERT( event_test_fired[3] == 1 );
+  TEST_ASSERT( event_next_event == 150 );
+
+  event_remove_type( type2 );
+  TEST_ASSERT( event_next_event == 200 );
+
+  event_frame( 150 );
+  TEST_ASSERT( event_next_event == 50 );
+
+  tstates = 50;
+  event_do_events();
+
+  TEST_ASSERT( event_test_count == 5 );
+  TEST_ASSERT( event_test_fired[4] == 5 );
+  TEST_ASSERT( event_next_event == 0xffffffff );
+
+  tstates = old_tstates;
+
+  return 0;
+}
+
 static int
 assert_page( libspectrum_word base, libspectrum_word length, int source, int page )
 {
@@ -786,6 +858,10 @@ unittests_run( void )
   r += mempool_test();
   r += paging_test();
   r += debugger_disassemble_unittest();
+  r += event_test();
+  r += debugger_breakpoint_unittest();
+  r += sound_ay_unittest();
+  r += pokefinder_unittest();
 
   printf("Final return value: %d (should be 0)\n", r);
 
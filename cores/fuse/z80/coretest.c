@@ -420,6 +420,20 @@ profile_map( libspectrum_word pc GCC_UNUSED )
   abort();
 }
 
+int profile_sampling = 0;
+
+void
+profile_call( libspectrum_word function GCC_UNUSED )
+{
+  abort();
+}
+
+void
+profile_return( void )
+{
+  abort();
+}
+
 int
 debugger_check( debugger_breakpoint_type type GCC_UNUSED, libspectrum_dword value GCC_UNUSED )
 {
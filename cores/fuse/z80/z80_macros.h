@@ -217,6 +217,7 @@ void contend_write_no_mreq( libspectrum_word address, libspectrum_dword time );
   contend_read_no_mreq( PC, 1 ); PC++;\
   PUSH16(PCL,PCH);\
   PC=z80.memptr.w;\
+  if( profile_sampling ) profile_call( PC );\
 }
 
 #define CP(value)\
@@ -328,6 +329,7 @@ break
 {\
   POP16(PCL,PCH);\
   z80.memptr.w = PC;\
+  if( profile_sampling ) profile_return();\
 }
 
 #define RL(value)\
@@ -366,6 +368,7 @@ break
   PUSH16(PCL,PCH);\
   PC=(value);\
   z80.memptr.w=PC;\
+  if( profile_sampling ) profile_call( PC );\
 }
 
 #define SBC(value)\
@@ -82,6 +82,10 @@ typedef struct snapshot_block_t {
   libspectrum_snap *snap;
   int automatic;
 
+  /* Bitmap of the RAM pages in `snap' which are identical to, and so
+     share their data with, an earlier snapshot block */
+  libspectrum_qword shared_pages;
+
 } snapshot_block_t;
 
 typedef struct signature_block_t {
@@ -205,6 +209,10 @@ block_free( rzx_block_t *block )
     return LIBSPECTRUM_ERROR_NONE;
 
   case LIBSPECTRUM_RZX_SNAPSHOT_BLOCK:
+    /* Shared pages belong to an earlier block, so don't free them here */
+    for( i = 0; i < SNAPSHOT_RAM_PAGES; i++ )
+      if( block->types.snap.shared_pages & ( (libspectrum_qword)1 << i ) )
+        libspectrum_snap_set_pages( block->types.snap.snap, i, NULL );
     libspectrum_snap_free( block->types.snap.snap );
     libspectrum_free( block );
     return LIBSPECTRUM_ERROR_NONE;
@@ -240,6 +248,60 @@ block_free_wrapper( gpointer data, gpointer user_data )
   block_free( data );
 }
 
+/* Before the snapshot block at `item' is removed from the middle of a
+   recording, pass ownership of any of its RAM pages which are still
+   shared by a later snapshot block on to that block */
+static void
+snapshot_block_hand_over( GSList *item )
+{
+  snapshot_block_t *snap_block = &( ((rzx_block_t*)item->data)->types.snap );
+  libspectrum_byte *page;
+  libspectrum_qword bit;
+  GSList *list;
+  size_t i;
+
+  for( i = 0; i < SNAPSHOT_RAM_PAGES; i++ ) {
+
+    bit = (libspectrum_qword)1 << i;
+    page = libspectrum_snap_pages( snap_block->snap, i );
+    if( !page || snap_block->shared_pages & bit ) continue;
+
+    for( list = item->next; list; list = list->next ) {
+      rzx_block_t *later = list->data;
+
+      if( later->type == LIBSPECTRUM_RZX_SNAPSHOT_BLOCK &&
+          libspectrum_snap_pages( later->types.snap.snap, i ) == page ) {
+        later->types.snap.shared_pages &= ~bit;
+        libspectrum_snap_set_pages( snap_block->snap, i, NULL );
+        break;
+      }
+    }
+  }
+}
+
+/* Replace any RAM pages in `snap_block' which are identical to those in
+   `previous' with references to the earlier copy */
+static void
+snapshot_block_share_pages( snapshot_block_t *snap_block,
+                            const snapshot_block_t *previous )
+{
+  libspectrum_byte *page, *previous_page;
+  size_t i;
+
+  for( i = 0; i < SNAPSHOT_RAM_PAGES; i++ ) {
+
+    page = libspectrum_snap_pages( snap_block->snap, i );
+    previous_page = libspectrum_snap_pages( previous->snap, i );
+
+    if( page && previous_page && page != previous_page &&
+        !memcmp( page, previous_page, 0x4000 ) ) {
+      libspectrum_free( page );
+      libspectrum_snap_set_pages( snap_block->snap, i, previous_page );
+      snap_block->shared_pages |= (libspectrum_qword)1 << i;
+    }
+  }
+}
+
 static gint
 find_block( gconstpointer a, gconstpointer b )
 {
@@ -292,7 +354,8 @@ libspectrum_rzx_stop_input( libspectrum_rzx *rzx )
 libspectrum_error
 libspectrum_rzx_add_snap( libspectrum_rzx *rzx, libspectrum_snap *snap, int automatic )
 {
-  rzx_block_t *block;
+  rzx_block_t *block, *previous;
+  GSList *list;
 
   libspectrum_rzx_stop_input( rzx );
 
@@ -300,6 +363,19 @@ libspectrum_rzx_add_snap( libspectrum_rzx *rzx, libspectrum_snap *snap, int auto
 
   block->types.snap.snap = snap;
   block->types.snap.automatic = automatic;
+  block->types.snap.shared_pages = 0;
+
+  /* Most of memory is normally unchanged since the last snapshot, so
+     share those pages rather than keeping another copy of them */
+  previous = NULL;
+  for( list = rzx->blocks; list; list = list->next ) {
+    if( ((rzx_block_t*)list->data)->type == LIBSPECTRUM_RZX_SNAPSHOT_BLOCK )
+      previous = list->data;
+  }
+
+  if( previous )
+    snapshot_block_share_pages( &( block->types.snap ),
+                                &( previous->types.snap ) );
 
   rzx->blocks = g_slist_append( rzx->blocks, block );
 
@@ -933,6 +1009,7 @@ rzx_read_snapshot( libspectrum_rzx *rzx, const libspectrum_byte **ptr,
   block_alloc( &block, LIBSPECTRUM_RZX_SNAPSHOT_BLOCK );
   block->types.snap.snap = libspectrum_snap_alloc();
   block->types.snap.automatic = 0;
+  block->types.snap.shared_pages = 0;
 
   snap = block->types.snap.snap;
 
@@ -1606,6 +1683,7 @@ libspectrum_rzx_insert_snap( libspectrum_rzx *rzx, libspectrum_snap *snap,
   block_alloc( &block, LIBSPECTRUM_RZX_SNAPSHOT_BLOCK );
   block->types.snap.snap = snap;
   block->types.snap.automatic = 0;
+  block->types.snap.shared_pages = 0;
 
   rzx->blocks = g_slist_insert( rzx->blocks, block, where );
 }
@@ -1655,6 +1733,9 @@ void
 libspectrum_rzx_iterator_delete( libspectrum_rzx *rzx,
 				 libspectrum_rzx_iterator it )
 {
+  if( ((rzx_block_t*)it->data)->type == LIBSPECTRUM_RZX_SNAPSHOT_BLOCK )
+    snapshot_block_hand_over( it );
+
   block_free( it->data );
 
   rzx->blocks = g_slist_delete_link( rzx->blocks, it );
@@ -1723,6 +1804,7 @@ libspectrum_rzx_finalise( libspectrum_rzx *rzx )
       if( first_snap ) {
         first_snap = 0;
       } else {
+        snapshot_block_hand_over( item );
         block_free( block );
         rzx->blocks = g_slist_delete_link( rzx->blocks, item );
         finalised = 1;
@@ -35,6 +35,19 @@ typedef struct szx_context {
 
 } szx_context;
 
+/* The last RAM page written, along with its on-disk form, so that runs
+   of identical pages (typically the empty memory of the larger machines)
+   need only be deflated once */
+
+typedef struct szx_page_cache {
+
+  const libspectrum_byte *data;
+  size_t length;
+  libspectrum_buffer *stored;
+  int use_compression;
+
+} szx_page_cache;
+
 /* The machine numbers used in the .szx format */
 
 typedef enum szx_machine_type {
@@ -272,15 +285,21 @@ static void
 write_keyb_chunk( libspectrum_buffer *buffer, libspectrum_buffer *data,
 		  int *out_flags, libspectrum_snap *snap );
 static void
+page_cache_init( szx_page_cache *cache );
+static void
+page_cache_end( szx_page_cache *cache );
+static void
 write_ram_pages( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
                  libspectrum_snap *snap, int compress );
 static void
 write_ramp_chunk( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
-                  libspectrum_snap *snap, int page, int compress );
+                  libspectrum_snap *snap, int page, int compress,
+                  szx_page_cache *cache );
 static void
 write_ram_page( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
                 const char *id, const libspectrum_byte *data,
-                size_t data_length, int page, int compress, int extra_flags );
+                size_t data_length, int page, int compress, int extra_flags,
+                szx_page_cache *cache );
 static libspectrum_error
 write_rom_chunk( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
                  int *out_flags, libspectrum_snap *snap, int compress );
@@ -307,13 +326,15 @@ write_zxat_chunk( libspectrum_buffer *buffer, libspectrum_buffer *data,
                   libspectrum_snap *snap );
 static void
 write_atrp_chunk( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
-		  libspectrum_snap *snap, int page, int compress );
+		  libspectrum_snap *snap, int page, int compress,
+		  szx_page_cache *cache );
 static void
 write_zxcf_chunk( libspectrum_buffer *buffer, libspectrum_buffer *data,
 		  libspectrum_snap *snap );
 static void
 write_cfrp_chunk( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
-                  libspectrum_snap *snap, int page, int compress );
+                  libspectrum_snap *snap, int page, int compress,
+                  szx_page_cache *cache );
 static void
 write_side_chunk( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
 		  libspectrum_snap *snap );
@@ -2725,6 +2746,7 @@ libspectrum_szx_write( libspectrum_buffer *buffer, int *out_flags,
   libspectrum_error error;
   size_t i;
   libspectrum_buffer *block_data;
+  szx_page_cache cache;
 
   *out_flags = 0;
 
@@ -2787,17 +2809,21 @@ libspectrum_szx_write( libspectrum_buffer *buffer, int *out_flags,
   if( libspectrum_snap_zxatasp_active( snap ) ) {
     write_zxat_chunk( buffer, block_data, snap );
 
+    page_cache_init( &cache );
     for( i = 0; i < libspectrum_snap_zxatasp_pages( snap ); i++ ) {
-      write_atrp_chunk( buffer, block_data, snap, i, compress );
+      write_atrp_chunk( buffer, block_data, snap, i, compress, &cache );
     }
+    page_cache_end( &cache );
   }
 
   if( libspectrum_snap_zxcf_active( snap ) ) {
     write_zxcf_chunk( buffer, block_data, snap );
 
+    page_cache_init( &cache );
     for( i = 0; i < libspectrum_snap_zxcf_pages( snap ); i++ ) {
-      write_cfrp_chunk( buffer, block_data, snap, i, compress );
+      write_cfrp_chunk( buffer, block_data, snap, i, compress, &cache );
     }
+    page_cache_end( &cache );
   }
 
   if( libspectrum_snap_interface2_active( snap ) ) {
@@ -3313,42 +3339,60 @@ write_rom_chunk( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
   return LIBSPECTRUM_ERROR_NONE;
 }
 
+static void
+page_cache_init( szx_page_cache *cache )
+{
+  cache->data = NULL;
+  cache->length = 0;
+  cache->stored = libspectrum_buffer_alloc();
+  cache->use_compression = 0;
+}
+
+static void
+page_cache_end( szx_page_cache *cache )
+{
+  libspectrum_buffer_free( cache->stored );
+}
+
 static void
 write_ram_pages( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
                  libspectrum_snap *snap, int compress )
 {
   libspectrum_machine machine;
   int i, capabilities; 
+  szx_page_cache cache;
+
+  page_cache_init( &cache );
 
   machine = libspectrum_snap_machine( snap );
   capabilities = libspectrum_machine_capabilities( machine );
 
-  write_ramp_chunk( buffer, block_data, snap, 5, compress );
+  write_ramp_chunk( buffer, block_data, snap, 5, compress, &cache );
 
   if( machine != LIBSPECTRUM_MACHINE_16 ) {
-    write_ramp_chunk( buffer, block_data, snap, 2, compress );
-    write_ramp_chunk( buffer, block_data, snap, 0, compress );
+    write_ramp_chunk( buffer, block_data, snap, 2, compress, &cache );
+    write_ramp_chunk( buffer, block_data, snap, 0, compress, &cache );
   }
 
   if( capabilities & LIBSPECTRUM_MACHINE_CAPABILITY_128_MEMORY ) {
-    write_ramp_chunk( buffer, block_data, snap, 1, compress );
-    write_ramp_chunk( buffer, block_data, snap, 3, compress );
-    write_ramp_chunk( buffer, block_data, snap, 4, compress );
-    write_ramp_chunk( buffer, block_data, snap, 6, compress );
-    write_ramp_chunk( buffer, block_data, snap, 7, compress );
+    write_ramp_chunk( buffer, block_data, snap, 1, compress, &cache );
+    write_ramp_chunk( buffer, block_data, snap, 3, compress, &cache );
+    write_ramp_chunk( buffer, block_data, snap, 4, compress, &cache );
+    write_ramp_chunk( buffer, block_data, snap, 6, compress, &cache );
+    write_ramp_chunk( buffer, block_data, snap, 7, compress, &cache );
 
     if( capabilities & LIBSPECTRUM_MACHINE_CAPABILITY_SCORP_MEMORY ) {
       for( i = 8; i < 16; i++ ) {
-        write_ramp_chunk( buffer, block_data, snap, i, compress );
+        write_ramp_chunk( buffer, block_data, snap, i, compress, &cache );
       }
     } else if( capabilities & LIBSPECTRUM_MACHINE_CAPABILITY_PENT512_MEMORY ) {
       for( i = 8; i < 32; i++ ) {
-        write_ramp_chunk( buffer, block_data, snap, i, compress );
+        write_ramp_chunk( buffer, block_data, snap, i, compress, &cache );
       }
 
       if( capabilities & LIBSPECTRUM_MACHINE_CAPABILITY_PENT1024_MEMORY ) {
 	for( i = 32; i < 64; i++ ) {
-	  write_ramp_chunk( buffer, block_data, snap, i, compress );
+	  write_ramp_chunk( buffer, block_data, snap, i, compress, &cache );
 	}
       }
     }
@@ -3356,24 +3400,28 @@ write_ram_pages( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
   }
 
   if( capabilities & LIBSPECTRUM_MACHINE_CAPABILITY_SE_MEMORY ) {
-    write_ramp_chunk( buffer, block_data, snap, 8, compress );
+    write_ramp_chunk( buffer, block_data, snap, 8, compress, &cache );
   }
+
+  page_cache_end( &cache );
 }
 
 static void
 write_ramp_chunk( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
-                  libspectrum_snap *snap, int page, int compress )
+                  libspectrum_snap *snap, int page, int compress,
+                  szx_page_cache *cache )
 {
   const libspectrum_byte *data = libspectrum_snap_pages( snap, page );
 
   write_ram_page( buffer, block_data, ZXSTBID_RAMPAGE, data, 0x4000, page,
-                  compress, 0x00 );
+                  compress, 0x00, cache );
 }
 
 static void
 write_ram_page( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
                 const char *id, const libspectrum_byte *data,
-                size_t data_length, int page, int compress, int extra_flags )
+                size_t data_length, int page, int compress, int extra_flags,
+                szx_page_cache *cache )
 {
   libspectrum_buffer *data_buffer;
   int use_compression;
@@ -3381,7 +3429,23 @@ write_ram_page( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
   if( !data ) return;
 
   data_buffer = libspectrum_buffer_alloc();
-  use_compression = compress_data( data_buffer, data, data_length, compress );
+
+  if( cache && compress && cache->data && cache->length == data_length &&
+      !memcmp( cache->data, data, data_length ) ) {
+    libspectrum_buffer_write_buffer( data_buffer, cache->stored );
+    use_compression = cache->use_compression;
+  } else {
+    use_compression = compress_data( data_buffer, data, data_length,
+                                     compress );
+
+    if( cache && compress ) {
+      libspectrum_buffer_clear( cache->stored );
+      libspectrum_buffer_write_buffer( cache->stored, data_buffer );
+      cache->data = data;
+      cache->length = data_length;
+      cache->use_compression = use_compression;
+    }
+  }
 
   if( use_compression ) extra_flags |= ZXSTRF_COMPRESSED;
 
@@ -3754,12 +3818,13 @@ write_zxat_chunk( libspectrum_buffer *buffer, libspectrum_buffer *data,
 
 static void
 write_atrp_chunk( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
-		  libspectrum_snap *snap, int page, int compress )
+		  libspectrum_snap *snap, int page, int compress,
+		  szx_page_cache *cache )
 {
   const libspectrum_byte *data = libspectrum_snap_zxatasp_ram( snap, page );
 
   write_ram_page( buffer, block_data, ZXSTBID_ZXATASPRAMPAGE, data, 0x4000,
-                  page, compress, 0x00 );
+                  page, compress, 0x00, cache );
 }
 
 static void
@@ -3780,12 +3845,13 @@ write_zxcf_chunk( libspectrum_buffer *buffer, libspectrum_buffer *data,
 
 static void
 write_cfrp_chunk( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
-                  libspectrum_snap *snap, int page, int compress )
+                  libspectrum_snap *snap, int page, int compress,
+                  szx_page_cache *cache )
 {
   const libspectrum_byte *data = libspectrum_snap_zxcf_ram( snap, page );
 
   write_ram_page( buffer, block_data, ZXSTBID_ZXCFRAMPAGE, data, 0x4000, page,
-                  compress, 0x00 );
+                  compress, 0x00, cache );
 }
 
 #ifdef HAVE_ZLIB_H
@@ -3829,7 +3895,7 @@ write_dock_chunk( libspectrum_buffer *buffer, libspectrum_buffer *block_data,
   if( exrom_dock ) extra_flags |= ZXSTDOCKF_EXROMDOCK;
 
   write_ram_page( buffer, block_data, ZXSTBID_DOCK, data, 0x2000, page,
-                  compress, extra_flags );
+                  compress, extra_flags, NULL );
 }
 
 static void
@@ -3948,7 +4014,8 @@ write_divxxx_ram_chunk( libspectrum_buffer *buffer,
                         const char *id )
 {
   const libspectrum_byte *data = get_data( snap, page );
-  write_ram_page( buffer, block_data, id, data, 0x2000, page, compress, 0x00 );
+  write_ram_page( buffer, block_data, id, data, 0x2000, page, compress, 0x00,
+                  NULL );
 }
 
 static void
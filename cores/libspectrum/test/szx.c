@@ -599,6 +599,82 @@ test_67( void )
       ARRAY_SIZE(empty_ram_page_start) + 0x4000 );
 }
 
+/* Pages are written in the order 5, 2, 0, 1, 3, 4, 6, 7, 8, ..., 15.
+   Page 8 differs from page 7 by a single byte so must not be taken from
+   the cache, and page 9 repeats page 8 so is. Only the previous page is
+   cached, so page 15, which repeats page 3 after a run of empty pages, is
+   deliberately compressed again rather than deduplicated */
+static libspectrum_byte
+scorpion_page_fill( int page )
+{
+  switch( page ) {
+  case 3: case 15: return 0xaa;
+  case 7: case 8: case 9: return 0x55;
+  default: return 0x00;
+  }
+}
+
+test_return_t
+test_73( void )
+{
+  libspectrum_snap *snap;
+  libspectrum_buffer *buffer;
+  libspectrum_byte *ram;
+  int out_flags, page;
+  test_return_t r = TEST_PASS;
+
+  snap = libspectrum_snap_alloc();
+  libspectrum_snap_set_machine( snap, LIBSPECTRUM_MACHINE_SCORP );
+
+  for( page = 0; page < 16; page++ ) {
+    ram = libspectrum_new( libspectrum_byte, 0x4000 );
+    memset( ram, scorpion_page_fill( page ), 0x4000 );
+    if( page == 7 ) ram[ 0x1234 ] = 0x01;
+    libspectrum_snap_set_pages( snap, page, ram );
+  }
+
+  buffer = libspectrum_buffer_alloc();
+  libspectrum_szx_write( buffer, &out_flags, snap, NULL, 0 );
+  libspectrum_snap_free( snap );
+
+  snap = libspectrum_snap_alloc();
+  if( libspectrum_snap_read( snap, libspectrum_buffer_get_data( buffer ),
+                             libspectrum_buffer_get_data_size( buffer ),
+                             LIBSPECTRUM_ID_SNAPSHOT_SZX, NULL ) ) {
+    libspectrum_snap_free( snap );
+    libspectrum_buffer_free( buffer );
+    return TEST_INCOMPLETE;
+  }
+  libspectrum_buffer_free( buffer );
+
+  for( page = 0; page < 16 && r == TEST_PASS; page++ ) {
+    libspectrum_byte fill = scorpion_page_fill( page );
+    size_t i;
+
+    ram = libspectrum_snap_pages( snap, page );
+    if( !ram ) {
+      fprintf( stderr, "%s: page %d missing\n", progname, page );
+      r = TEST_FAIL;
+      break;
+    }
+
+    for( i = 0; i < 0x4000; i++ ) {
+      libspectrum_byte expected =
+        i == 0x1234 && page == 7 ? 0x01 : fill;
+      if( ram[i] != expected ) {
+        fprintf( stderr, "%s: page %d offset 0x%04lx is 0x%02x, not 0x%02x\n",
+                 progname, page, (unsigned long)i, ram[i], expected );
+        r = TEST_FAIL;
+        break;
+      }
+    }
+  }
+
+  libspectrum_snap_free( snap );
+
+  return r;
+}
+
 static test_return_t
 szx_read_block_test_with_template( const char *id, const char *template,
     int (*check_fn)( libspectrum_snap* ) )
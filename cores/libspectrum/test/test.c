@@ -816,6 +816,108 @@ test_71( void )
   return r;
 }
 
+/* Allocate a 128K snapshot with every RAM page filled with `fill',
+   except for page 1 which is filled with `page1_fill' */
+static libspectrum_snap*
+rzx_sharing_snap( libspectrum_byte fill, libspectrum_byte page1_fill )
+{
+  libspectrum_snap *snap = libspectrum_snap_alloc();
+  libspectrum_byte *page;
+  int i;
+
+  libspectrum_snap_set_machine( snap, LIBSPECTRUM_MACHINE_128 );
+
+  for( i = 0; i < 8; i++ ) {
+    page = libspectrum_new( libspectrum_byte, 0x4000 );
+    memset( page, i == 1 ? page1_fill : fill, 0x4000 );
+    libspectrum_snap_set_pages( snap, i, page );
+  }
+
+  return snap;
+}
+
+static int
+rzx_sharing_check( libspectrum_snap *snap, libspectrum_byte fill,
+                   libspectrum_byte page1_fill )
+{
+  libspectrum_byte *page;
+  size_t i, j;
+
+  for( i = 0; i < 8; i++ ) {
+    page = libspectrum_snap_pages( snap, i );
+    for( j = 0; j < 0x4000; j++ ) {
+      if( page[j] != ( i == 1 ? page1_fill : fill ) ) {
+        fprintf( stderr, "%s: page %lu has wrong contents\n", progname,
+                 (unsigned long)i );
+        return 1;
+      }
+    }
+  }
+
+  return 0;
+}
+
+static libspectrum_rzx_iterator
+rzx_sharing_nth_snap( libspectrum_rzx *rzx, int n )
+{
+  libspectrum_rzx_iterator it;
+
+  for( it = libspectrum_rzx_iterator_begin( rzx );
+       it;
+       it = libspectrum_rzx_iterator_next( it ) ) {
+    if( libspectrum_rzx_iterator_get_type( it ) ==
+          LIBSPECTRUM_RZX_SNAPSHOT_BLOCK &&
+        !n-- )
+      return it;
+  }
+
+  return NULL;
+}
+
+static test_return_t
+test_74( void )
+{
+  libspectrum_rzx *rzx = libspectrum_rzx_alloc();
+  libspectrum_snap *first, *second, *third, *snap;
+  test_return_t r = TEST_FAIL;
+
+  first = rzx_sharing_snap( 0xaa, 0x11 );
+  second = rzx_sharing_snap( 0xaa, 0x22 );
+  third = rzx_sharing_snap( 0xaa, 0x22 );
+
+  libspectrum_rzx_add_snap( rzx, first, 1 );
+  libspectrum_rzx_start_input( rzx, 0 );
+  libspectrum_rzx_add_snap( rzx, second, 1 );
+  libspectrum_rzx_start_input( rzx, 0 );
+  libspectrum_rzx_add_snap( rzx, third, 1 );
+  libspectrum_rzx_start_input( rzx, 0 );
+
+  if( libspectrum_snap_pages( second, 0 ) !=
+        libspectrum_snap_pages( first, 0 ) ||
+      libspectrum_snap_pages( second, 1 ) ==
+        libspectrum_snap_pages( first, 1 ) ||
+      libspectrum_snap_pages( third, 1 ) !=
+        libspectrum_snap_pages( second, 1 ) ) {
+    fprintf( stderr, "%s: pages not shared as expected\n", progname );
+    goto end;
+  }
+
+  /* Remove the snapshots which own the shared pages */
+  libspectrum_rzx_iterator_delete( rzx, rzx_sharing_nth_snap( rzx, 1 ) );
+  libspectrum_rzx_iterator_delete( rzx, rzx_sharing_nth_snap( rzx, 0 ) );
+
+  if( libspectrum_rzx_rollback( rzx, &snap ) ) goto end;
+
+  if( snap != third || rzx_sharing_check( snap, 0xaa, 0x22 ) ) goto end;
+
+  r = TEST_PASS;
+
+end:
+  libspectrum_rzx_free( rzx );
+
+  return r;
+}
+
 static test_return_t
 test_72( void )
 {
@@ -975,7 +1077,9 @@ static struct test_description tests[] = {
   { test_69, "Read uncompressed SZX ATRP chunk", 0 },
   { test_70, "Read uncompressed SZX CFRP chunk", 0 },
   { test_71, "Write RZX with incompressible snap", 0 },
-  { test_72, "Tape peek next block", 0 }
+  { test_72, "Tape peek next block", 0 },
+  { test_73, "Write SZX RAMP chunks with repeated pages", 0 },
+  { test_74, "Share unchanged pages between RZX snapshots", 0 }
 };
 
 static size_t test_count = ARRAY_SIZE( tests );
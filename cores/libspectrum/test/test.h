@@ -53,6 +53,7 @@ test_return_t test_62( void );
 test_return_t test_65( void );
 test_return_t test_66( void );
 test_return_t test_67( void );
+test_return_t test_73( void );
 
 /* SZX read tests */
 test_return_t test_44( void );
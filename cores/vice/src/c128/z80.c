@@ -30,6 +30,7 @@
 
 #include "6510core.h"
 #include "alarm.h"
+#include "c128mem.h"
 #include "daa.h"
 #include "debug.h"
 #include "interrupt.h"
@@ -134,10 +135,26 @@ inline static int z80mem_read_limit(int addr)
 
 #define opcode_t uint32_t
 
-#define FETCH_OPCODE(o) ((o) = (LOAD(z80_reg_pc)               \
-                                | (LOAD(z80_reg_pc + 1) << 8)  \
-                                | (LOAD(z80_reg_pc + 2) << 16) \
-                                | (LOAD(z80_reg_pc + 3) << 24)))
+/* The four opcode bytes are fetched for every instruction, so read them
+   straight from the current RAM bank when they all lie in a plain RAM page
+   (where CP/M code runs nearly all of the time) instead of going through
+   four read function calls.  */
+#define FETCH_OPCODE(o)                                                     \
+    do {                                                                    \
+        if (_z80mem_read_tab_ptr[z80_reg_pc >> 8] == ram_read               \
+            && (z80_reg_pc & 0xff) <= 0xfc) {                               \
+            const uint8_t *fetch_ptr = ram_bank + z80_reg_pc;               \
+            (o) = fetch_ptr[0]                                              \
+                  | (fetch_ptr[1] << 8)                                     \
+                  | (fetch_ptr[2] << 16)                                    \
+                  | ((opcode_t)fetch_ptr[3] << 24);                         \
+        } else {                                                            \
+            (o) = (LOAD(z80_reg_pc)                                         \
+                   | (LOAD(z80_reg_pc + 1) << 8)                            \
+                   | (LOAD(z80_reg_pc + 2) << 16)                           \
+                   | (LOAD(z80_reg_pc + 3) << 24));                         \
+        }                                                                   \
+    } while (0)
 
 #define p0 (opcode & 0xff)
 #define p1 ((opcode >> 8) & 0xff)
@@ -44,6 +44,7 @@
 #include "log.h"
 #include "machine.h"
 #include "maincpu.h"
+#include "serial.h"
 #include "sid-snapshot.h"
 #include "snapshot.h"
 #include "sound.h"
@@ -76,6 +77,7 @@ int c64_snapshot_write(const char *name, int save_roms, int save_disks, int even
         || ciacore_snapshot_write_module(machine_context.cia2, s) < 0
         || sid_snapshot_write_module(s) < 0
         || drive_snapshot_write_module(s, save_disks, save_roms) < 0
+        || serial_trap_snapshot_write_module(s) < 0
         || vicii_snapshot_write_module(s) < 0
         || c64_glue_snapshot_write_module(s) < 0
         || event_snapshot_write_module(s, event_mode) < 0
@@ -120,6 +122,7 @@ int c64_snapshot_read(const char *name, int event_mode)
         || ciacore_snapshot_read_module(machine_context.cia2, s) < 0
         || sid_snapshot_read_module(s) < 0
         || drive_snapshot_read_module(s) < 0
+        || serial_trap_snapshot_read_module(s) < 0
         || vicii_snapshot_read_module(s) < 0
         || c64_glue_snapshot_read_module(s) < 0
         || event_snapshot_read_module(s, event_mode) < 0
@@ -129,6 +129,12 @@ int datasette_sound_emulation = 1;
 /* volume of sound from datasette device */
 int datasette_sound_emulation_volume;
 
+/* run in warp mode while a tape is playing */
+static int datasette_auto_warp = 0;
+
+/* warp mode was turned on by the datasette */
+static int datasette_warp_active = 0;
+
 static log_t datasette_log = LOG_ERR;
 
 static void datasette_internal_reset(void);
@@ -137,6 +143,7 @@ static void datasette_control_internal(int command);
 
 static void datasette_set_motor(int flag);
 static void datasette_toggle_write_bit(int write_bit);
+static void datasette_update_warp(void);
 
 static int datasette_write_snapshot(snapshot_t *s, int write_image);
 static int datasette_read_snapshot(snapshot_t *s);
@@ -259,6 +266,15 @@ static int set_datasette_sound_emulation_volume(int val, void *param)
     return 0;
 }
 
+static int set_datasette_auto_warp(int val, void *param)
+{
+    datasette_auto_warp = val ? 1 : 0;
+
+    datasette_update_warp();
+
+    return 0;
+}
+
 static const resource_int_t resources_int[] = {
     { "Datasette", 1, RES_EVENT_SAME, NULL,
       &datasette_enable,
@@ -281,6 +297,9 @@ static const resource_int_t resources_int[] = {
     { "DatasetteSoundVolume", 1024, RES_EVENT_SAME, NULL,
       &datasette_sound_emulation_volume,
       set_datasette_sound_emulation_volume, NULL },
+    { "DatasetteAutoWarp", 0, RES_EVENT_NO, NULL,
+      &datasette_auto_warp,
+      set_datasette_auto_warp, NULL },
     RESOURCE_INT_LIST_END
 };
 
@@ -327,6 +346,12 @@ static const cmdline_option_t cmdline_options[] =
     { "-dssoundvolume", SET_RESOURCE, CMDLINE_ATTRIB_NEED_ARGS,
       NULL, NULL, "DatasetteSoundVolume", NULL,
       "<value>", "Set volume of Datasette sound" },
+    { "-dsautowarp", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
+      NULL, NULL, "DatasetteAutoWarp", (resource_value_t)1,
+      NULL, "Enable warp mode while the Datasette is playing" },
+    { "+dsautowarp", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
+      NULL, NULL, "DatasetteAutoWarp", (resource_value_t)0,
+      NULL, "Disable warp mode while the Datasette is playing" },
     CMDLINE_LIST_END
 };
 
@@ -627,6 +652,7 @@ static void datasette_read_bit(CLOCK offset, void *data)
         motor_stop_clk = 0;
         ui_display_tape_motor_status(0);
         datasette_motor = 0;
+        datasette_update_warp();
     }
     DBG(("datasette_read_bit(motor:%d)", datasette_motor));
 
@@ -806,6 +832,37 @@ void datasette_set_tape_image(tap_t *image)
     fullwave = 0;
 
     ui_set_tape_status(current_image ? 1 : 0);
+
+    datasette_update_warp();
+}
+
+/* Turn warp mode on while the motor is running and a tape is playing, and
+   back off when it stops.  The emulation itself is not changed, so loaders
+   see exactly the same timing. */
+static void datasette_update_warp(void)
+{
+    int playing, warp = 0;
+
+    if (event_playback_active()) {
+        return;
+    }
+
+    playing = datasette_auto_warp && datasette_motor
+              && current_image != NULL
+              && current_image->mode == DATASETTE_CONTROL_START;
+
+    if (playing && !datasette_warp_active) {
+        resources_get_int("WarpMode", &warp);
+        if (!warp) {
+            log_message(datasette_log, "Turning Warp mode on");
+            resources_set_int("WarpMode", 1);
+            datasette_warp_active = 1;
+        }
+    } else if (!playing && datasette_warp_active) {
+        log_message(datasette_log, "Turning Warp mode off");
+        resources_set_int("WarpMode", 0);
+        datasette_warp_active = 0;
+    }
 }
 
 
@@ -1019,6 +1076,8 @@ static void datasette_control_internal(int command)
     }
     /* clear the tap-buffer */
     last_tap = next_tap = 0;
+
+    datasette_update_warp();
 }
 
 void datasette_control(int command)
@@ -1050,6 +1109,7 @@ static void datasette_set_motor(int flag)
             datasette_start_motor();
             ui_display_tape_motor_status(1);
             datasette_motor = 1;
+            datasette_update_warp();
         }
     }
     if (!flag && datasette_motor && motor_stop_clk == 0) {
@@ -1123,6 +1183,7 @@ inline static void bit_write(void)
         current_image->cycle_counter_total = current_image->cycle_counter;
     }
     current_image->has_changed = 1;
+    current_image->data_stale = 1;
     datasette_update_ui_counter();
 }
 
@@ -148,6 +148,7 @@ extern unsigned int disk_image_header_gap_size(unsigned int format, unsigned int
 extern unsigned int disk_image_sync_size(unsigned int format, unsigned int track);
 
 extern int disk_image_read_image(const disk_image_t *image);
+extern int disk_image_read_half_track(const disk_image_t *image, unsigned int half_track);
 extern int disk_image_write_p64_image(const disk_image_t *image);
 extern int disk_image_write_half_track(disk_image_t *image, unsigned int half_track,
                                        const struct disk_track_s *raw);
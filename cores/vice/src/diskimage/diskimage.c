@@ -46,6 +46,7 @@
 #include "fsimage-gcr.h"
 #include "fsimage-p64.h"
 #include "fsimage.h"
+#include "gcr.h"
 #include "lib.h"
 #include "log.h"
 #include "realimage.h"
@@ -718,6 +719,8 @@ int disk_image_write_half_track(disk_image_t *image, unsigned int half_track,
 
 int disk_image_read_image(const disk_image_t *image)
 {
+    memset(image->gcr->pending, 0, sizeof(image->gcr->pending));
+
     switch (image->type) {
         case DISK_IMAGE_TYPE_P64:
             return fsimage_read_p64_image(image);
@@ -729,6 +732,19 @@ int disk_image_read_image(const disk_image_t *image)
     }
 }
 
+/* Convert a half track that was left pending by disk_image_read_image().
+   `half_track' counts from 2, like in disk_image_write_half_track().  */
+int disk_image_read_half_track(const disk_image_t *image, unsigned int half_track)
+{
+    if (image->gcr == NULL
+        || half_track < 2 || half_track - 2 >= MAX_GCR_TRACKS
+        || !image->gcr->pending[half_track - 2]) {
+        return 0;
+    }
+
+    return fsimage_dxx_read_half_track(image, half_track);
+}
+
 int disk_image_write_p64_image(const disk_image_t *image)
 {
     return fsimage_write_p64_image(image);
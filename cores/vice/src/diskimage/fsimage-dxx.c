@@ -51,7 +51,7 @@ int fsimage_dxx_write_half_track(disk_image_t *image, unsigned int half_track,
     long offset;
     uint8_t *buffer;
     fsimage_t *fsimage = image->media.fsimage;
-    fdc_err_t rf;
+    fdc_err_t rf, *rfs;
 
     track = half_track / 2;
 
@@ -75,8 +75,10 @@ int fsimage_dxx_write_half_track(disk_image_t *image, unsigned int half_track,
     }
 
     buffer = lib_calloc(max_sector, 256);
+    rfs = lib_malloc(max_sector * sizeof(fdc_err_t));
+    gcr_read_sectors(raw, buffer, max_sector, rfs);
     for (sector = 0; sector < max_sector; sector++) {
-        rf = gcr_read_sector(raw, &buffer[sector * 256], (uint8_t)sector);
+        rf = rfs[sector];
         if (rf != CBMDOS_FDC_ERR_OK) {
             log_error(fsimage_dxx_log,
                       "Could not find data sector of T:%u S:%u.",
@@ -100,6 +102,7 @@ int fsimage_dxx_write_half_track(disk_image_t *image, unsigned int half_track,
             }
         }
     }
+    lib_free(rfs);
     offset = sectors * 256;
 
 #ifdef HAVE_X64_IMAGE
@@ -107,7 +110,7 @@ int fsimage_dxx_write_half_track(disk_image_t *image, unsigned int half_track,
         offset += X64_HEADER_LENGTH;
     }
 #endif
-    if (util_fpwrite(fsimage->fd, buffer, max_sector * 256, offset) < 0) {
+    if (fsimage_write_bytes(fsimage, buffer, max_sector * 256, offset) < 0) {
         log_error(fsimage_dxx_log, "Error writing T:%u to disk image.",
                   track);
         lib_free(buffer);
@@ -125,10 +128,10 @@ int fsimage_dxx_write_half_track(disk_image_t *image, unsigned int half_track,
 #endif
             fsimage->error_info.dirty = 0;
             if (error_info_created) {
-                res = util_fpwrite(fsimage->fd, fsimage->error_info.map,
+                res = fsimage_write_bytes(fsimage, fsimage->error_info.map,
                                    fsimage->error_info.len, fsimage->error_info.len * 256);
             } else {
-                res = util_fpwrite(fsimage->fd, fsimage->error_info.map + sectors,
+                res = fsimage_write_bytes(fsimage, fsimage->error_info.map + sectors,
                                    max_sector, offset);
             }
             if (res < 0) {
@@ -145,22 +148,14 @@ int fsimage_dxx_write_half_track(disk_image_t *image, unsigned int half_track,
     return 0;
 }
 
-int fsimage_read_dxx_image(const disk_image_t *image)
+/* Read the disk IDs from the BAM. The second side of a double sided D71
+   has its own ID.  */
+static void fsimage_dxx_read_ids(const disk_image_t *image)
 {
     uint8_t buffer[256], *bam_id;
-    int gap, headergap, synclen;
-    unsigned int track, sector, track_size;
-    gcr_header_t header;
-    fdc_err_t rf;
-    int double_sided = 0;
     fsimage_t *fsimage = image->media.fsimage;
-    unsigned int max_sector;
-    uint8_t *ptr;
-    int half_track;
+    gcr_t *gcr = image->gcr;
     int sectors;
-    long offset;
-    /* unsigned long trackoffset = 0; */
-    uint8_t *tempgcr;
 
     if (image->type == DISK_IMAGE_TYPE_D80
         || image->type == DISK_IMAGE_TYPE_D82) {
@@ -173,112 +168,130 @@ int fsimage_read_dxx_image(const disk_image_t *image)
 
     bam_id[0] = bam_id[1] = 0xa0;
     if (sectors >= 0) {
-        util_fpread(fsimage->fd, buffer, 256, sectors << 8);
+        fsimage_read_bytes(fsimage, buffer, 256, sectors << 8);
     }
-    header.id1 = bam_id[0];
-    header.id2 = bam_id[1];
+    gcr->pending_id[0][0] = gcr->pending_id[1][0] = bam_id[0];
+    gcr->pending_id[0][1] = gcr->pending_id[1][1] = bam_id[1];
 
     /* check double sided images */
-    double_sided = (image->type == DISK_IMAGE_TYPE_D71) && !(buffer[0x03] & 0x80);
+    gcr->pending_double_sided = (image->type == DISK_IMAGE_TYPE_D71)
+                                && !(buffer[0x03] & 0x80);
+    if (gcr->pending_double_sided) {
+        sectors = disk_image_check_sector(image, BAM_TRACK_1571 + 35, BAM_SECTOR_1571);
+
+        buffer[BAM_ID_1571] = buffer[BAM_ID_1571 + 1] = 0xa0;
+        if (sectors >= 0) {
+            fsimage_read_bytes(fsimage, buffer, 256, sectors << 8);
+        }
+        gcr->pending_id[1][0] = buffer[BAM_ID_1571];
+        gcr->pending_id[1][1] = buffer[BAM_ID_1571 + 1];
+    }
+}
 
-    for (header.track = track = 1; track <= image->max_half_tracks / 2; track++, header.track++) {
-        half_track = track * 2 - 2;
+/* Get the disk ID and the track number to put into the sector headers of
+   `track', as they were when the image was attached.  */
+static void fsimage_dxx_get_header(const disk_image_t *image, unsigned int track,
+                                   gcr_header_t *header)
+{
+    const gcr_t *gcr = image->gcr;
+    int side = 0;
 
-        track_size = disk_image_raw_track_size(image->type, track);
-        if (image->gcr->tracks[half_track].data == NULL) {
-            image->gcr->tracks[half_track].data = lib_malloc(track_size);
-        } else if (image->gcr->tracks[half_track].size != (int)track_size) {
-            image->gcr->tracks[half_track].data = lib_realloc(image->gcr->tracks[half_track].data, track_size);
-        }
-        ptr = image->gcr->tracks[half_track].data;
-        image->gcr->tracks[half_track].size = track_size;
+    header->track = track;
+    if (gcr->pending_double_sided && track >= 36) {
+        side = 1;
+        header->track = track - 35;
+    }
+    header->id1 = gcr->pending_id[side][0];
+    header->id2 = gcr->pending_id[side][1];
+}
 
-        if (track <= image->tracks) {
-            /* get temp buffer */
-            ptr = tempgcr = lib_malloc(track_size);
+/* Tracks are only converted to GCR when the drive first needs them, see
+   fsimage_dxx_read_half_track(). Attaching just marks them as pending.  */
+int fsimage_read_dxx_image(const disk_image_t *image)
+{
+    unsigned int half_track;
 
-            if (double_sided && track == 36) {
-                sectors = disk_image_check_sector(image, BAM_TRACK_1571 + 35, BAM_SECTOR_1571);
+    fsimage_dxx_read_ids(image);
 
-                buffer[BAM_ID_1571] = buffer[BAM_ID_1571 + 1] = 0xa0;
-                if (sectors >= 0) {
-                    util_fpread(fsimage->fd, buffer, 256, sectors << 8);
-                }
-                header.id1 = buffer[BAM_ID_1571]; /* second side, update id and track */
-                header.id2 = buffer[BAM_ID_1571 + 1];
-                header.track = 1;
-            }
+    for (half_track = 0; half_track < image->max_half_tracks; half_track++) {
+        image->gcr->pending[half_track] = 1;
+    }
+    return 0;
+}
+
+int fsimage_dxx_read_half_track(const disk_image_t *image, unsigned int half_track)
+{
+    uint8_t buffer[256];
+    int gap, headergap, synclen;
+    unsigned int track, sector, track_size;
+    gcr_header_t header;
+    fdc_err_t rf;
+    fsimage_t *fsimage = image->media.fsimage;
+    unsigned int max_sector;
+    uint8_t *ptr;
+    disk_track_t *raw;
+    int sectors;
+    long offset;
+
+    track = half_track / 2;
+    raw = &image->gcr->tracks[half_track - 2];
+    image->gcr->pending[half_track - 2] = 0;
+
+    track_size = disk_image_raw_track_size(image->type, track);
+    if (raw->data == NULL) {
+        raw->data = lib_malloc(track_size);
+    } else if (raw->size != (int)track_size) {
+        raw->data = lib_realloc(raw->data, track_size);
+    }
+    ptr = raw->data;
+    raw->size = track_size;
+
+    /* Clear odd track */
+    if (half_track & 1) {
+        /* FIXME: filling with 0x55 like for the empty tracks below does not
+           work for some reason (skew.d64 fails) */
+        memset(ptr, 0, track_size);
+        return 0;
+    }
+
+    /* Clear track to avoid read errors.  */
+    memset(ptr, 0x55, track_size);
+
+    if (track > image->tracks) {
+        return 0;
+    }
 
-            gap = disk_image_gap_size(image->type, track);
-            headergap = disk_image_header_gap_size(image->type, track);
-            synclen = disk_image_sync_size(image->type, track);
+    fsimage_dxx_get_header(image, track, &header);
 
-            max_sector = disk_image_sector_per_track(image->type, track);
+    gap = disk_image_gap_size(image->type, track);
+    headergap = disk_image_header_gap_size(image->type, track);
+    synclen = disk_image_sync_size(image->type, track);
 
-            /* Clear track to avoid read errors.  */
-            memset(ptr, 0x55, track_size);
+    max_sector = disk_image_sector_per_track(image->type, track);
 
-            for (sector = 0; sector < max_sector; sector++) {
-                sectors = disk_image_check_sector(image, track, sector);
-                offset = sectors * 256;
+    for (sector = 0; sector < max_sector; sector++) {
+        sectors = disk_image_check_sector(image, track, sector);
+        offset = sectors * 256;
 
 #ifdef HAVE_X64_IMAGE
-                if (image->type == DISK_IMAGE_TYPE_X64) {
-                    offset += X64_HEADER_LENGTH;
-                }
+        if (image->type == DISK_IMAGE_TYPE_X64) {
+            offset += X64_HEADER_LENGTH;
+        }
 #endif
-                if (sectors >= 0) {
-                    rf = CBMDOS_FDC_ERR_DRIVE;
-                    if (util_fpread(fsimage->fd, buffer, 256, offset) >= 0) {
-                        if (fsimage->error_info.map != NULL) {
-                            rf = fsimage->error_info.map[sectors];
-                        }
-                    }
-                    header.sector = sector;
-                    gcr_convert_sector_to_GCR(buffer, ptr, &header, headergap, synclen, rf);
+        if (sectors >= 0) {
+            rf = CBMDOS_FDC_ERR_DRIVE;
+            if (fsimage_read_bytes(fsimage, buffer, 256, offset) >= 0) {
+                if (fsimage->error_info.map != NULL) {
+                    rf = fsimage->error_info.map[sectors];
                 }
-
-                ptr += SECTOR_GCR_SIZE_WITH_HEADER + headergap + gap + (synclen * 2);
             }
-
-            ptr = image->gcr->tracks[half_track].data;
-#if 1
-            memcpy(ptr, tempgcr, track_size);
-#else
-            /* FIXME: copy gcr data to final buffer with offset+wraparound */
-            memset(ptr, 0x55, track_size);
-            trackoffset %= track_size;
-            memcpy(ptr + trackoffset, tempgcr, track_size - trackoffset);
-            memcpy(ptr, tempgcr + (track_size - trackoffset), track_size - (track_size - trackoffset));
-            trackoffset += 200; /* FIXME */
-#endif
-            lib_free(tempgcr);
-        } else {
-            memset(ptr, 0x55, track_size);
+            header.sector = sector;
+            gcr_convert_sector_to_GCR(buffer, ptr, &header, headergap, synclen, rf);
         }
 
-        /* Clear odd track */
-        half_track++;
-#if 0
-        /* this does not work for some reason (skew.d64 fails) */
-        if (image->gcr->tracks[half_track].data) {
-            image->gcr->tracks[half_track].size = track_size;
-            ptr = image->gcr->tracks[half_track].data;
-            memset(ptr, 0, track_size);
-        }
-#else
-        /* create an (empty) half track */
-        if (image->gcr->tracks[half_track].data == NULL) {
-            image->gcr->tracks[half_track].data = lib_malloc(track_size);
-        } else if (image->gcr->tracks[half_track].size != (int)track_size) {
-            image->gcr->tracks[half_track].data = lib_realloc(image->gcr->tracks[half_track].data, track_size);
-        }
-        image->gcr->tracks[half_track].size = track_size;
-        ptr = image->gcr->tracks[half_track].data;
-        memset(ptr, 0, track_size);        
-#endif
-        
+        ptr += SECTOR_GCR_SIZE_WITH_HEADER + headergap + gap + (synclen * 2);
     }
+
     return 0;
 }
 
@@ -305,7 +318,7 @@ int fsimage_dxx_read_sector(const disk_image_t *image, uint8_t *buf, const disk_
     }
 #endif
     if (image->gcr == NULL) {
-        if (util_fpread(fsimage->fd, buf, 256, offset) < 0) {
+        if (fsimage_read_bytes(fsimage, buf, 256, offset) < 0) {
             log_error(fsimage_dxx_log,
                       "Error reading T:%u S:%u from disk image.",
                       dadr->track, dadr->sector);
@@ -314,6 +327,7 @@ int fsimage_dxx_read_sector(const disk_image_t *image, uint8_t *buf, const disk_
             rf = fsimage->error_info.map ? fsimage->error_info.map[sectors] : CBMDOS_FDC_ERR_OK;
         }
     } else {
+        disk_image_read_half_track(image, dadr->track * 2);
         rf = gcr_read_sector(&image->gcr->tracks[(dadr->track * 2) - 2], buf, (uint8_t)dadr->sector);
         /* HACK: if the image has an error map, and the "FDC" did not detect an 
            error in the GCR stream, use the error from the error map instead.
@@ -378,12 +392,13 @@ int fsimage_dxx_write_sector(disk_image_t *image, const uint8_t *buf, const disk
         offset += X64_HEADER_LENGTH;
     }
 #endif
-    if (util_fpwrite(fsimage->fd, buf, 256, offset) < 0) {
+    if (fsimage_write_bytes(fsimage, buf, 256, offset) < 0) {
         log_error(fsimage_dxx_log, "Error writing T:%u S:%u to disk image.",
                   dadr->track, dadr->sector);
         return -1;
     }
-    if (image->gcr != NULL) {
+    /* a track that is still pending is converted from the updated image */
+    if (image->gcr != NULL && !image->gcr->pending[(dadr->track * 2) - 2]) {
         gcr_write_sector(&image->gcr->tracks[(dadr->track * 2) - 2], buf, (uint8_t)dadr->sector);
     }
 
@@ -397,7 +412,7 @@ int fsimage_dxx_write_sector(disk_image_t *image, const uint8_t *buf, const disk
         }
 #endif
         fsimage->error_info.map[sectors] = CBMDOS_FDC_ERR_OK;
-        if (util_fpwrite(fsimage->fd, &fsimage->error_info.map[sectors], 1, offset) < 0) {
+        if (fsimage_write_bytes(fsimage, &fsimage->error_info.map[sectors], 1, offset) < 0) {
             log_error(fsimage_dxx_log,
                     "Error writing T:%u S:%u error info to disk image.",
                     dadr->track, dadr->sector);
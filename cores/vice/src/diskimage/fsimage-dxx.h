@@ -36,6 +36,7 @@ struct disk_addr_s;
 extern void fsimage_dxx_init(void);
 
 extern int fsimage_read_dxx_image(const disk_image_t *image);
+extern int fsimage_dxx_read_half_track(const disk_image_t *image, unsigned int half_track);
 
 extern int fsimage_dxx_write_half_track(disk_image_t *image, unsigned int half_track,
                                         const struct disk_track_s *raw);
@@ -78,7 +78,7 @@ static long fsimage_gcr_seek_half_track(fsimage_t *fsimage, unsigned int half_tr
         log_error(fsimage_gcr_log, "Attempt to read without disk image.");
         return -1;
     }
-    if (util_fpread(fsimage->fd, buf, 12, 0) < 0) {
+    if (fsimage_read_bytes(fsimage, buf, 12, 0) < 0) {
         log_error(fsimage_gcr_log, "Could not read GCR disk image.");
         return -1;
     }
@@ -105,7 +105,7 @@ static long fsimage_gcr_seek_half_track(fsimage_t *fsimage, unsigned int half_tr
     }
 #endif
 
-    if (util_fpread(fsimage->fd, buf, 4, 12 + (half_track - 2) * 4) < 0) {
+    if (fsimage_read_bytes(fsimage, buf, 4, 12 + (half_track - 2) * 4) < 0) {
         log_error(fsimage_gcr_log, "Could not read GCR disk image.");
         return -1;
     }
@@ -137,7 +137,7 @@ int fsimage_gcr_read_half_track(const disk_image_t *image, unsigned int half_tra
     }
 
     if (offset != 0) {
-        if (util_fpread(fsimage->fd, buf, 2, offset) < 0) {
+        if (fsimage_read_bytes(fsimage, buf, 2, offset) < 0) {
             log_error(fsimage_gcr_log, "Could not read GCR disk image.");
             return -1;
         }
@@ -154,7 +154,7 @@ int fsimage_gcr_read_half_track(const disk_image_t *image, unsigned int half_tra
         raw->data = lib_calloc(1, track_len);
         raw->size = track_len;
 
-        if (fread(raw->data, track_len, 1, fsimage->fd) < 1) {
+        if (fsimage_read_bytes(fsimage, raw->data, track_len, offset + 2) < 0) {
             log_error(fsimage_gcr_log, "Could not read GCR disk image.");
             return -1;
         }
@@ -220,14 +220,14 @@ int fsimage_gcr_write_half_track(disk_image_t *image, unsigned int half_track,
     if (raw->data != NULL) {
         util_word_to_le_buf(buf, (uint16_t)raw->size);
 
-        if (util_fpwrite(fsimage->fd, buf, 2, offset) < 0) {
+        if (fsimage_write_bytes(fsimage, buf, 2, offset) < 0) {
             log_error(fsimage_gcr_log, "Could not write GCR disk image.");
             return -1;
         }
 
         /* Clear gap between the end of the actual track and the start of
            the next track.  */
-        if (fwrite(raw->data, raw->size, 1, fsimage->fd) < 1) {
+        if (fsimage_write_bytes(fsimage, raw->data, raw->size, offset + 2) < 0) {
             log_error(fsimage_gcr_log, "Could not write GCR disk image.");
             return -1;
         }
@@ -235,9 +235,9 @@ int fsimage_gcr_write_half_track(disk_image_t *image, unsigned int half_track,
 
         if (gap > 0) {
             uint8_t *padding = lib_calloc(1, gap);
-            res = fwrite(padding, gap, 1, fsimage->fd);
+            res = fsimage_write_bytes(fsimage, padding, gap, offset + 2 + raw->size);
             lib_free(padding);
-            if (res < 1) {
+            if (res < 0) {
                 log_error(fsimage_gcr_log, "Could not write GCR disk image.");
                 return -1;
             }
@@ -250,13 +250,13 @@ int fsimage_gcr_write_half_track(disk_image_t *image, unsigned int half_track,
              *        -- compyx 2020-07-24
              */
             util_dword_to_le_buf(buf, (uint32_t)offset);
-            if (util_fpwrite(fsimage->fd, buf, 4, 12 + (half_track - 2) * 4) < 0) {
+            if (fsimage_write_bytes(fsimage, buf, 4, 12 + (half_track - 2) * 4) < 0) {
                 log_error(fsimage_gcr_log, "Could not write GCR disk image.");
                 return -1;
             }
 
             util_dword_to_le_buf(buf, disk_image_speed_map(image->type, half_track / 2));
-            if (util_fpwrite(fsimage->fd, buf, 4, 12 + (half_track - 2 + num_half_tracks) * 4) < 0) {
+            if (fsimage_write_bytes(fsimage, buf, 4, 12 + (half_track - 2 + num_half_tracks) * 4) < 0) {
                 log_error(fsimage_gcr_log, "Could not write GCR disk image.");
                 return -1;
             }
@@ -28,6 +28,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "archdep.h"
 #include "diskconstants.h"
@@ -47,6 +48,9 @@
 
 static log_t fsimage_log = LOG_DEFAULT;
 
+/* Largest image that is kept in memory while attached. */
+#define FSIMAGE_DATA_MAX (16 * 1024 * 1024)
+
 
 /** \brief  Set image name
  *
@@ -123,6 +127,117 @@ void fsimage_media_destroy(disk_image_t *image)
 
 /*-----------------------------------------------------------------------*/
 
+/** \brief  Load the contents of \a image into memory
+ *
+ * Sector and track reads are then served from memory, writes go to the file
+ * and to the in-memory copy. Only done for image types that are accessed
+ * exclusively through fsimage_read_bytes() and fsimage_write_bytes().
+ *
+ * \param[in,out]  image   disk image
+ */
+static void fsimage_load(disk_image_t *image)
+{
+    fsimage_t *fsimage;
+    size_t size;
+
+    fsimage = image->media.fsimage;
+
+    switch (image->type) {
+        case DISK_IMAGE_TYPE_D64:
+        case DISK_IMAGE_TYPE_D67:
+        case DISK_IMAGE_TYPE_D71:
+        case DISK_IMAGE_TYPE_D81:
+        case DISK_IMAGE_TYPE_D80:
+        case DISK_IMAGE_TYPE_D82:
+#ifdef HAVE_X64_IMAGE
+        case DISK_IMAGE_TYPE_X64:
+#endif
+        case DISK_IMAGE_TYPE_D1M:
+        case DISK_IMAGE_TYPE_D2M:
+        case DISK_IMAGE_TYPE_D4M:
+        case DISK_IMAGE_TYPE_D90:
+        case DISK_IMAGE_TYPE_G64:
+        case DISK_IMAGE_TYPE_G71:
+            break;
+        default:
+            /* P64 is read as a whole anyway, the CMD HD accesses DHD images
+               through the file directly. */
+            return;
+    }
+
+    size = util_file_length(fsimage->fd);
+    if (size == 0 || size > FSIMAGE_DATA_MAX) {
+        return;
+    }
+
+    fsimage->data = lib_malloc(size);
+    if (util_fpread(fsimage->fd, fsimage->data, size, 0) < 0) {
+        log_warning(fsimage_log, "Cannot load `%s' into memory.", fsimage->name);
+        lib_free(fsimage->data);
+        fsimage->data = NULL;
+        return;
+    }
+    fsimage->size = size;
+}
+
+
+/** \brief  Read \a num bytes at \a offset from the image
+ *
+ * \param[in]  fsimage    file system image
+ * \param[out] buf        buffer to read into
+ * \param[in]  num        number of bytes to read
+ * \param[in]  offset     offset in image
+ *
+ * \return   0 on success, -1 on error
+ */
+int fsimage_read_bytes(fsimage_t *fsimage, void *buf, size_t num, long offset)
+{
+    if (fsimage->data != NULL) {
+        if (offset < 0 || (size_t)offset > fsimage->size || num > fsimage->size - (size_t)offset) {
+            return -1;
+        }
+        memcpy(buf, fsimage->data + offset, num);
+        return 0;
+    }
+
+    return util_fpread(fsimage->fd, buf, num, offset);
+}
+
+
+/** \brief  Write \a num bytes at \a offset to the image
+ *
+ * The data is written to the file and to the in-memory copy, which grows
+ * with the file if the image is extended.
+ *
+ * \param[in,out]  fsimage    file system image
+ * \param[in]      buf        data to write
+ * \param[in]      num        number of bytes to write
+ * \param[in]      offset     offset in image
+ *
+ * \return  0 on success, -1 on error
+ */
+int fsimage_write_bytes(fsimage_t *fsimage, const void *buf, size_t num, long offset)
+{
+    if (util_fpwrite(fsimage->fd, buf, num, offset) < 0) {
+        return -1;
+    }
+
+    if (fsimage->data != NULL) {
+        if ((size_t)offset + num > fsimage->size) {
+            fsimage->data = lib_realloc(fsimage->data, (size_t)offset + num);
+            if ((size_t)offset > fsimage->size) {
+                memset(fsimage->data + fsimage->size, 0, (size_t)offset - fsimage->size);
+            }
+            fsimage->size = (size_t)offset + num;
+        }
+        memcpy(fsimage->data + offset, buf, num);
+    }
+
+    return 0;
+}
+
+/*-----------------------------------------------------------------------*/
+
 int fsimage_open(disk_image_t *image)
 {
     fsimage_t *fsimage;
@@ -148,6 +263,7 @@ int fsimage_open(disk_image_t *image)
     }
 
     if (fsimage_probe(image) == 0) {
+        fsimage_load(image);
         return 0;
     }
 
@@ -175,6 +291,9 @@ int fsimage_close(disk_image_t *image)
         lib_free(fsimage->error_info.map);
         fsimage->error_info.map = NULL;
     }
+    lib_free(fsimage->data);
+    fsimage->data = NULL;
+    fsimage->size = 0;
     zfile_fclose(fsimage->fd);
     fsimage->fd = NULL;
 
@@ -42,6 +42,8 @@ typedef struct fsimage_s {
         int dirty;
         int len;
     } error_info;
+    uint8_t *data;      /* in-memory copy of the image, NULL if not loaded */
+    size_t size;        /* size of the in-memory copy */
 } fsimage_t;
 
 
@@ -61,4 +63,7 @@ extern int fsimage_write_sector(struct disk_image_s *image, const uint8_t *buf,
                                 const struct disk_addr_s *dadr);
 extern uint32_t fsimage_size(const disk_image_t *image);
 
+extern int fsimage_read_bytes(fsimage_t *fsimage, void *buf, size_t num, long offset);
+extern int fsimage_write_bytes(fsimage_t *fsimage, const void *buf, size_t num, long offset);
+
 #endif
@@ -1048,6 +1048,9 @@ static int drive_snapshot_write_gcrimage_module(snapshot_t *s, unsigned int dnr)
 
     /* Write half track data */
     for (i = 0; i < num_half_tracks; i++) {
+        if (drive->image) {
+            disk_image_read_half_track(drive->image, i + 2);
+        }
         data = drive->gcr->tracks[i].data;
         track_size = data ? drive->gcr->tracks[i].size : 0;
         if (0
@@ -1127,6 +1130,7 @@ static int drive_snapshot_read_gcrimage_module(snapshot_t *s, unsigned int dnr)
         }
         data = drive->gcr->tracks[i].data;
         drive->gcr->tracks[i].size = track_size;
+        drive->gcr->pending[i] = 0;
 
         if (track_size && SMR_BA(m, data, track_size) < 0) {
             snapshot_module_close(m);
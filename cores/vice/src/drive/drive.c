@@ -630,6 +630,10 @@ void drive_set_half_track(int num, int side, drive_t *dptr)
     /* FIXME: why would the offset be different for D71 and G71? */
     tmp = (dptr->image && dptr->image->type == DISK_IMAGE_TYPE_G71) ? DRIVE_HALFTRACKS_1571 : 70;
 
+    if (dptr->image) {
+        disk_image_read_half_track(dptr->image, dptr->current_half_track + (dptr->side * tmp));
+    }
+
     dptr->GCR_track_start_ptr = dptr->gcr->tracks[dptr->current_half_track - 2 + (dptr->side * tmp)].data;
 
     if (dptr->GCR_current_track_size != 0) {
@@ -238,6 +238,7 @@ int drive_image_detach(disk_image_t *image, unsigned int unit, unsigned int drv)
     }
 
     for (i = 0; i < MAX_GCR_TRACKS; i++) {
+        drive->gcr->pending[i] = 0;
         if (drive->gcr->tracks[i].data) {
             lib_free(drive->gcr->tracks[i].data);
             drive->gcr->tracks[i].data = NULL;
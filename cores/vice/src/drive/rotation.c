@@ -641,7 +641,8 @@ static void rotation_1541_p64(drive_t *dptr, int ref_cycles)
         P64PulseStream->CurrentIndex = -1;
     } else {
         if (P64PulseStream->CurrentIndex < 0) {
-            P64PulseStream->CurrentIndex = P64PulseStream->UsedFirst;
+            /* e.g. after a head step, find the first pulse behind the head */
+            P64PulseStream->CurrentIndex = P64PulseStreamFindPulse(P64PulseStream, rptr->PulseHeadPosition + 1);
         } else {
             while ((P64PulseStream->CurrentIndex >= 0) &&
                    ((P64PulseStream->CurrentIndex != P64PulseStream->UsedFirst) &&
@@ -772,11 +773,7 @@ static void rotation_1541_p64(drive_t *dptr, int ref_cycles)
                 if (rptr->PulseHeadPosition >= P64PulseSamplesPerRotation) {
                     rptr->PulseHeadPosition -= P64PulseSamplesPerRotation;
 
-                    P64PulseStream->CurrentIndex = P64PulseStream->UsedFirst;
-                    while ((P64PulseStream->CurrentIndex >= 0) &&
-                           (P64PulseStream->Pulses[P64PulseStream->CurrentIndex].Position < rptr->PulseHeadPosition)) {
-                        P64PulseStream->CurrentIndex = P64PulseStream->Pulses[P64PulseStream->CurrentIndex].Next;
-                    }
+                    P64PulseStream->CurrentIndex = P64PulseStreamFindPulse(P64PulseStream, rptr->PulseHeadPosition);
                     DeltaPositionToNextPulse = rotation_p64_get_delta(dptr);
                 }
 
@@ -891,11 +888,7 @@ static void rotation_1541_p64(drive_t *dptr, int ref_cycles)
                 rptr->PulseHeadPosition += ToDo;
                 if (rptr->PulseHeadPosition >= P64PulseSamplesPerRotation) {
                     rptr->PulseHeadPosition -= P64PulseSamplesPerRotation;
-                    P64PulseStream->CurrentIndex = P64PulseStream->UsedFirst;
-                    while ((P64PulseStream->CurrentIndex >= 0) &&
-                           (P64PulseStream->Pulses[P64PulseStream->CurrentIndex].Position < rptr->PulseHeadPosition)) {
-                        P64PulseStream->CurrentIndex = P64PulseStream->Pulses[P64PulseStream->CurrentIndex].Next;
-                    }
+                    P64PulseStream->CurrentIndex = P64PulseStreamFindPulse(P64PulseStream, rptr->PulseHeadPosition);
                 }
 
                 /* Write head handling */
@@ -52,6 +52,7 @@
 #include "resources.h"
 #include "snapshot.h"
 #include "tape.h"
+#include "tick.h"
 #include "types.h"
 #include "uiapi.h"
 #include "util.h"
@@ -62,6 +63,7 @@
 #define EVENT_START_SNAPSHOT "start" FSDEV_EXT_SEP_STR "vsf"
 #define EVENT_END_SNAPSHOT "end" FSDEV_EXT_SEP_STR "vsf"
 #define EVENT_MILESTONE_SNAPSHOT "milestone" FSDEV_EXT_SEP_STR "vsf"
+#define EVENT_KEYFRAME_SNAPSHOT "keyframe%05u" FSDEV_EXT_SEP_STR "vsf"
 
 
 /** \brief  Size of the CRC32 entries
@@ -78,10 +80,50 @@ struct event_image_list_s {
 };
 typedef struct event_image_list_s event_image_list_t;
 
+/** \brief  Keyframe snapshot taken while recording
+ *
+ * Keyframes are full machine snapshots written every EventKeyframeInterval
+ * seconds. They are marked by an EVENT_KEYFRAME entry in the event list and
+ * listed in the EVENTIDX snapshot module, so playback can be restarted from
+ * the keyframe nearest to a requested time instead of from the start.
+ */
+struct event_keyframe_s {
+    unsigned int second;    /**< time of the keyframe in the recording */
+    unsigned int timestamp; /**< number of timestamps before the keyframe */
+    char *filename;         /**< snapshot file, relative to EventSnapshotDir */
+    event_list_t *event;    /**< EVENT_KEYFRAME entry in the event list */
+};
+typedef struct event_keyframe_s event_keyframe_t;
+
 static event_list_state_t *event_list = NULL;
 static event_image_list_t *event_image_list_base = NULL;
 static int image_number;
 
+static event_keyframe_t *keyframes = NULL;
+static unsigned int keyframes_num, keyframes_max;
+static unsigned int keyframes_interval;
+
+/* last entry handled during playback, needed to insert keyframes */
+static event_list_t *playback_previous = NULL;
+
+/* adding keyframes to a history while playing it back */
+static int convert_requested = 0, convert_active = 0;
+
+/* seeking: warp until this timestamp is reached */
+static unsigned int seek_target, seek_active, seek_warp_mode;
+static unsigned long seek_start_tick;
+
+/* seek requested before playback was started, e.g. on the command line */
+static int seek_requested = 0;
+static unsigned int seek_requested_second;
+
+/* seek latency benchmark: seek to fractions of the history in turn */
+static const unsigned int seek_bench_percent[] = { 25, 50, 75, 100, 10 };
+#define SEEK_BENCH_NUM (sizeof(seek_bench_percent) / sizeof(seek_bench_percent[0]))
+static int seek_bench_requested = 0, seek_bench_active = 0;
+static unsigned int seek_bench_step;
+static unsigned long seek_bench_total;
+
 static alarm_t *event_alarm = NULL;
 
 static log_t event_log = LOG_DEFAULT;
@@ -101,6 +143,8 @@ static char *event_end_snapshot = NULL;
 static char *event_snapshot_path_str = NULL;
 static int event_start_mode;
 static int event_image_include;
+static int event_keyframe_interval;
+static int event_keyframe_disks;
 
 static char *event_snapshot_path(const char *snapshot_file)
 {
@@ -343,6 +387,7 @@ void event_record_in_list(event_list_state_t *list, unsigned int type,
         case EVENT_ATTACHIMAGE:         /* fall through */
         case EVENT_INITIAL:             /* fall through */
         case EVENT_SYNC_TEST:           /* fall through */
+        case EVENT_KEYFRAME:            /* fall through */
         case EVENT_RESOURCE:
             event_data = lib_malloc(size);
             memcpy(event_data, data, size);
@@ -372,6 +417,225 @@ void event_record(unsigned int type, void *data, unsigned int size)
     }
 }
 
+/*-----------------------------------------------------------------------*/
+/* keyframe index                                                        */
+
+static void keyframe_add(event_list_t *event, const char *filename,
+                         unsigned int second, unsigned int timestamp)
+{
+    event_keyframe_t *keyframe;
+
+    if (keyframes_num == keyframes_max) {
+        keyframes_max = keyframes_max ? keyframes_max * 2 : 16;
+        keyframes = lib_realloc(keyframes,
+                                keyframes_max * sizeof(event_keyframe_t));
+    }
+
+    keyframe = &keyframes[keyframes_num++];
+    keyframe->second = second;
+    keyframe->timestamp = timestamp;
+    keyframe->filename = (filename != NULL) ? lib_strdup(filename) : NULL;
+    keyframe->event = event;
+}
+
+/* drops all keyframes from index `num` on */
+static void keyframes_truncate(unsigned int num)
+{
+    while (keyframes_num > num) {
+        keyframes_num--;
+        lib_free(keyframes[keyframes_num].filename);
+    }
+}
+
+/* drops the keyframes that are not in the event list before `end` */
+static void keyframes_cut(event_list_t *end)
+{
+    event_list_t *curr;
+    unsigned int num = 0;
+
+    for (curr = event_list->base; curr != NULL && curr != end; curr = curr->next) {
+        if (curr->type == EVENT_KEYFRAME) {
+            num++;
+        }
+    }
+
+    keyframes_truncate(num);
+}
+
+static void keyframes_destroy(void)
+{
+    keyframes_truncate(0);
+    lib_free(keyframes);
+    keyframes_max = 0;
+}
+
+/* returns the last keyframe at or before `second`, or NULL if there is none */
+static event_keyframe_t *keyframe_find(unsigned int second)
+{
+    unsigned int i;
+
+    if (keyframes_num == 0 || keyframes_interval == 0) {
+        return NULL;
+    }
+
+    /* Keyframes are written every keyframes_interval seconds, so this is
+       normally the right one already.  Recordings continued from a
+       milestone or from playback may have shifted the grid.  */
+    i = second / keyframes_interval;
+    if (i > keyframes_num) {
+        i = keyframes_num;
+    }
+    while (i > 0 && keyframes[i - 1].second > second) {
+        i--;
+    }
+    while (i < keyframes_num && keyframes[i].second <= second) {
+        i++;
+    }
+
+    return (i > 0) ? &keyframes[i - 1] : NULL;
+}
+
+static char *keyframe_snapshot_write(void)
+{
+    char *filename;
+
+    filename = lib_msprintf(EVENT_KEYFRAME_SNAPSHOT, keyframes_num);
+
+    /* Keyframes are only used to seek within this history, so ROMs are
+       left out, and disk images unless asked for: every keyframe would
+       otherwise hold a full copy of each attached image.  */
+    if (machine_write_snapshot(event_snapshot_path(filename), 0,
+                               event_keyframe_disks, 0) < 0) {
+        log_error(event_log, "Could not create keyframe snapshot file %s.",
+                  event_snapshot_path(filename));
+        lib_free(filename);
+        return NULL;
+    }
+
+    return filename;
+}
+
+static void event_record_keyframe_trap(uint16_t addr, void *data)
+{
+    event_list_t *event;
+    char *filename;
+    uint8_t number[4];
+
+    if (record_active == 0) {
+        return;
+    }
+
+    filename = keyframe_snapshot_write();
+    if (filename == NULL) {
+        return;
+    }
+
+    /* event_record() fills the current entry */
+    event = event_list->current;
+    util_dword_to_le_buf(number, keyframes_num);
+    event_record(EVENT_KEYFRAME, number, (unsigned int)sizeof(number));
+
+    keyframe_add(event, filename, vice_ptr_to_uint(data), current_timestamp);
+    lib_free(filename);
+}
+
+/* inserts a keyframe into an existing history while playing it back */
+static void event_convert_keyframe_trap(uint16_t addr, void *data)
+{
+    event_list_t *event;
+    char *filename;
+
+    if (convert_active == 0) {
+        return;
+    }
+
+    filename = keyframe_snapshot_write();
+    if (filename == NULL) {
+        return;
+    }
+
+    event = lib_calloc(1, sizeof(event_list_t));
+    event->type = EVENT_KEYFRAME;
+    event->clk = maincpu_clk;
+    event->size = 4;
+    event->data = lib_malloc(event->size);
+    util_dword_to_le_buf(event->data, keyframes_num);
+
+    /* the new entry is in the past, so it goes before the pending one */
+    event->next = event_list->current;
+    if (playback_previous != NULL) {
+        playback_previous->next = event;
+    } else {
+        event_list->base = event;
+    }
+    playback_previous = event;
+
+    keyframe_add(event, filename, vice_ptr_to_uint(data), current_timestamp);
+    lib_free(filename);
+}
+
+static void event_convert_finish_trap(uint16_t addr, void *data)
+{
+    convert_active = 0;
+
+    /* The machine is in the same state as when the recording was stopped,
+       so the end snapshot can be replaced with one including the index.  */
+    if (machine_write_snapshot(event_snapshot_path(event_end_snapshot), 1, 1, 1) < 0) {
+        ui_error("Could not create end snapshot file %s.", event_snapshot_path(event_end_snapshot));
+    } else {
+        log_message(event_log, "Added %u keyframes to event history.", keyframes_num);
+    }
+
+    event_playback_stop();
+}
+
+static void event_playback_seek_trap(uint16_t addr, void *data);
+
+static unsigned int seek_bench_target(void)
+{
+    unsigned int second;
+
+    second = playback_time * seek_bench_percent[seek_bench_step] / 100;
+
+    /* the last timestamp is followed by the end of the list */
+    return (second > 0 && second == playback_time) ? second - 1 : second;
+}
+
+static void seek_bench_next(unsigned long ms)
+{
+    seek_bench_total += ms;
+    seek_bench_step++;
+
+    if (seek_bench_step < SEEK_BENCH_NUM) {
+        interrupt_maincpu_trigger_trap(event_playback_seek_trap,
+                                       uint_to_void_ptr(seek_bench_target()));
+        return;
+    }
+
+    log_message(event_log, "Seek benchmark: %u seeks in %lu ms, %lu ms average.",
+                (unsigned int)SEEK_BENCH_NUM, seek_bench_total,
+                seek_bench_total / SEEK_BENCH_NUM);
+    seek_bench_active = 0;
+    event_playback_stop();
+}
+
+static void event_playback_seek_done(void)
+{
+    unsigned long ms;
+
+    ms = tick_delta(seek_start_tick) / (tick_per_second() / 1000);
+
+    if (seek_active) {
+        seek_active = 0;
+        resources_set_int("WarpMode", (int)seek_warp_mode);
+    }
+
+    log_message(event_log, "Seek to %u s took %lu ms.", seek_target, ms);
+
+    if (seek_bench_active) {
+        seek_bench_next(ms);
+    }
+}
 
 static void next_alarm_set(void)
 {
@@ -388,6 +652,7 @@ static void next_alarm_set(void)
 }
 static void next_current_list(void)
 {
+    playback_previous = event_list->current;
     event_list->current = event_list->current->next;
 }
 
@@ -397,6 +662,11 @@ static void event_alarm_handler(CLOCK offset, void *data)
 
     /* when recording set a timestamp */
     if (record_active) {
+        if (keyframes_interval > 0 && current_timestamp > 0
+            && current_timestamp % keyframes_interval == 0) {
+            interrupt_maincpu_trigger_trap(event_record_keyframe_trap,
+                                           uint_to_void_ptr(current_timestamp));
+        }
         ui_display_event_time(current_timestamp++, 0);
         next_timestamp_clk = next_timestamp_clk + (CLOCK)machine_get_cycles_per_second();
         alarm_set(event_alarm, next_timestamp_clk);
@@ -445,12 +715,25 @@ static void event_alarm_handler(CLOCK offset, void *data)
             machine_reset_event_playback(offset, event_list->current->data);
             break;
         case EVENT_TIMESTAMP:
+            if (convert_active && current_timestamp > 0
+                && current_timestamp % keyframes_interval == 0) {
+                interrupt_maincpu_trigger_trap(event_convert_keyframe_trap,
+                                               uint_to_void_ptr(current_timestamp));
+            }
             ui_display_event_time(current_timestamp++, playback_time);
+            if (seek_active && current_timestamp > seek_target) {
+                event_playback_seek_done();
+            }
             break;
         case EVENT_LIST_END:
-            event_playback_stop();
+            if (convert_active) {
+                interrupt_maincpu_trigger_trap(event_convert_finish_trap, NULL);
+            } else {
+                event_playback_stop();
+            }
             break;
         case EVENT_OVERFLOW:
+        case EVENT_KEYFRAME:
             break;
         default:
             log_error(event_log, "Unknow event type %u.",
@@ -543,6 +826,7 @@ static void create_list(void)
     event_list = lib_malloc(sizeof(event_list_state_t));
     event_register_event_list(event_list);
     event_init_image_list();
+    keyframes_interval = (unsigned int)event_keyframe_interval;
 }
 
 
@@ -589,6 +873,7 @@ static void destroy_list(void)
     event_clear_list(event_list);
     lib_free(event_list);
     event_destroy_image_list();
+    keyframes_destroy();
 }
 
 static void warp_end_list(void)
@@ -719,6 +1004,7 @@ static void event_record_start_trap(uint16_t addr, void *data)
             current_timestamp = 0;
             break;
         case EVENT_START_MODE_PLAYBACK:
+            keyframes_cut(event_list->current);
             cut_list(event_list->current->next);
             event_list->current->next = NULL;
             event_list->current->type = EVENT_LIST_END;
@@ -827,7 +1113,10 @@ static void event_playback_start_trap(uint16_t addr, void *unused)
 {
     snapshot_t *s;
     uint8_t minor, major;
+    int convert = convert_requested;
 
+    convert_requested = 0;
+    convert_active = 0;
     event_version[0] = 0;
 
     s = snapshot_open(
@@ -852,6 +1141,7 @@ static void event_playback_start_trap(uint16_t addr, void *unused)
     snapshot_close(s);
 
     event_list->current = event_list->base;
+    playback_previous = NULL;
 
     if (event_list->current->type == EVENT_INITIAL) {
         uint8_t *data = (uint8_t *)(event_list->current->data);
@@ -899,8 +1189,30 @@ static void event_playback_start_trap(uint16_t addr, void *unused)
     playback_active = 1;
     current_timestamp = 0;
 
+    if (convert) {
+        if (keyframes_num > 0) {
+            log_message(event_log, "Event history already has keyframes.");
+        } else {
+            keyframes_interval = (unsigned int)event_keyframe_interval;
+            convert_active = 1;
+        }
+    }
+
     ui_display_playback(1, event_version);
 
+    if (seek_bench_requested && !convert_active) {
+        seek_bench_requested = 0;
+        seek_bench_active = 1;
+        seek_bench_step = 0;
+        seek_bench_total = 0;
+        log_message(event_log, "Seek benchmark: %u s history, %u keyframes.",
+                    playback_time, keyframes_num);
+        event_playback_seek_trap(addr, uint_to_void_ptr(seek_bench_target()));
+    } else if (seek_requested && !convert_active) {
+        seek_requested = 0;
+        event_playback_seek_trap(addr, uint_to_void_ptr(seek_requested_second));
+    }
+
 #ifdef  DEBUG
     debug_start_playback();
 #endif
@@ -924,6 +1236,17 @@ int event_playback_stop(void)
         return -1;
     }
 
+    if (convert_active) {
+        log_warning(event_log, "Playback stopped, keyframes were not saved.");
+        convert_active = 0;
+    }
+
+    if (seek_active) {
+        seek_active = 0;
+        resources_set_int("WarpMode", (int)seek_warp_mode);
+    }
+    seek_bench_active = 0;
+
     playback_active = 0;
 
     alarm_unset(event_alarm);
@@ -937,6 +1260,85 @@ int event_playback_stop(void)
     return 0;
 }
 
+static void event_playback_seek_trap(uint16_t addr, void *data)
+{
+    event_keyframe_t *keyframe;
+    unsigned int second = vice_ptr_to_uint(data);
+
+    if (playback_active == 0) {
+        return;
+    }
+
+    seek_start_tick = tick_now();
+    seek_target = second;
+
+    keyframe = keyframe_find(second);
+
+    if (keyframe == NULL) {
+        /* target is before the first keyframe, start over */
+        event_playback_start_trap(addr, NULL);
+        if (playback_active == 0) {
+            return;
+        }
+    } else {
+        if (machine_read_snapshot(event_snapshot_path(keyframe->filename), 0) < 0) {
+            ui_error("Error reading keyframe snapshot file %s.", event_snapshot_path(keyframe->filename));
+            return;
+        }
+
+        playback_previous = keyframe->event;
+        event_list->current = keyframe->event->next;
+        current_timestamp = keyframe->timestamp;
+        next_alarm_set();
+    }
+
+    log_message(event_log, "Restored %u s in %lu ms.",
+                keyframe != NULL ? keyframe->second : 0,
+                tick_delta(seek_start_tick) / (tick_per_second() / 1000));
+
+    /* run the rest of the way in warp mode */
+    if (current_timestamp <= second) {
+        if (!seek_active) {
+            int warp;
+
+            resources_get_int("WarpMode", &warp);
+            seek_warp_mode = (unsigned int)warp;
+            resources_set_int("WarpMode", 1);
+        }
+        seek_active = 1;
+    } else {
+        event_playback_seek_done();
+    }
+}
+
+int event_playback_seek(unsigned int seconds)
+{
+    if (playback_active == 0 || convert_active) {
+        return -1;
+    }
+
+    interrupt_maincpu_trigger_trap(event_playback_seek_trap, uint_to_void_ptr(seconds));
+
+    return 0;
+}
+
+int event_playback_convert(void)
+{
+    if (event_keyframe_interval <= 0) {
+        log_error(event_log, "EventKeyframeInterval must be set to convert an event history.");
+        return -1;
+    }
+
+    convert_requested = 1;
+
+    if (event_playback_start() < 0) {
+        convert_requested = 0;
+        return -1;
+    }
+
+    return 0;
+}
+
 static void event_record_set_milestone_trap(uint16_t addr, void *data)
 {
     if (machine_write_snapshot(event_snapshot_path(event_end_snapshot), 1, 1, 1) < 0) {
@@ -1014,6 +1416,73 @@ int event_playback_active(void)
 
 /*-----------------------------------------------------------------------*/
 
+/* The keyframe index is optional; if it is missing or broken the history
+   can still be played back, just not seeked.  */
+static void event_index_read_module(struct snapshot_s *s)
+{
+    snapshot_module_t *m;
+    uint8_t major_version, minor_version;
+    unsigned int interval, num, i;
+
+    m = snapshot_module_open(s, "EVENTIDX", &major_version, &minor_version);
+
+    if (m == NULL) {
+        keyframes_truncate(0);
+        return;
+    }
+
+    if (SMR_DW_UINT(m, &interval) < 0
+        || SMR_DW_UINT(m, &num) < 0
+        || num != keyframes_num) {
+        goto fail;
+    }
+
+    for (i = 0; i < num; i++) {
+        if (SMR_DW_UINT(m, &keyframes[i].second) < 0
+            || SMR_STR(m, &keyframes[i].filename) < 0
+            || keyframes[i].filename == NULL) {
+            goto fail;
+        }
+    }
+
+    keyframes_interval = interval;
+    snapshot_module_close(m);
+    return;
+
+fail:
+    log_warning(event_log, "Ignoring invalid keyframe index.");
+    keyframes_truncate(0);
+    snapshot_module_close(m);
+}
+
+static int event_index_write_module(struct snapshot_s *s)
+{
+    snapshot_module_t *m;
+    unsigned int i;
+
+    m = snapshot_module_create(s, "EVENTIDX", 0, 0);
+
+    if (m == NULL) {
+        return -1;
+    }
+
+    if (SMW_DW(m, (uint32_t)keyframes_interval) < 0
+        || SMW_DW(m, (uint32_t)keyframes_num) < 0) {
+        snapshot_module_close(m);
+        return -1;
+    }
+
+    for (i = 0; i < keyframes_num; i++) {
+        if (SMW_DW(m, (uint32_t)keyframes[i].second) < 0
+            || SMW_STR(m, keyframes[i].filename) < 0) {
+            snapshot_module_close(m);
+            return -1;
+        }
+    }
+
+    return snapshot_module_close(m);
+}
+
 int event_snapshot_read_module(struct snapshot_s *s, int event_mode)
 {
     snapshot_module_t *m;
@@ -1107,6 +1576,10 @@ int event_snapshot_read_module(struct snapshot_s *s, int event_mode)
         curr->size = size;
         curr->data = (size > 0 ? data : NULL);
 
+        if (type == EVENT_KEYFRAME) {
+            keyframe_add(curr, NULL, 0, num_of_timestamps);
+        }
+
         if (type == EVENT_LIST_END) {
             break;
         }
@@ -1125,6 +1598,8 @@ int event_snapshot_read_module(struct snapshot_s *s, int event_mode)
 
     snapshot_module_close(m);
 
+    event_index_read_module(s);
+
     return 0;
 }
 
@@ -1162,6 +1637,10 @@ int event_snapshot_write_module(struct snapshot_s *s, int event_mode)
         return -1;
     }
 
+    if (keyframes_num > 0 && event_index_write_module(s) < 0) {
+        return -1;
+    }
+
     return 0;
 }
 
@@ -1224,6 +1703,24 @@ static int set_event_image_include(int enable, void *param)
     return 0;
 }
 
+static int set_event_keyframe_interval(int seconds, void *param)
+{
+    if (seconds < 0) {
+        return -1;
+    }
+
+    event_keyframe_interval = seconds;
+
+    return 0;
+}
+
+static int set_event_keyframe_disks(int enable, void *param)
+{
+    event_keyframe_disks = enable ? 1 : 0;
+
+    return 0;
+}
+
 static const resource_string_t resources_string[] = {
     { "EventSnapshotDir",
       FSDEVICE_DEFAULT_DIR FSDEV_DIR_SEP_STR, RES_EVENT_NO, NULL,
@@ -1240,6 +1737,10 @@ static const resource_int_t resources_int[] = {
       &event_start_mode, set_event_start_mode, NULL },
     { "EventImageInclude", 1, RES_EVENT_NO, NULL,
       &event_image_include, set_event_image_include, NULL },
+    { "EventKeyframeInterval", 0, RES_EVENT_NO, NULL,
+      &event_keyframe_interval, set_event_keyframe_interval, NULL },
+    { "EventKeyframeDisks", 0, RES_EVENT_NO, NULL,
+      &event_keyframe_disks, set_event_keyframe_disks, NULL },
     RESOURCE_INT_LIST_END
 };
 
@@ -1269,6 +1770,39 @@ static int cmdline_help(const char *param, void *extra_param)
     return event_playback_start();
 }
 
+static int cmdline_convert(const char *param, void *extra_param)
+{
+    return event_playback_convert();
+}
+
+static int cmdline_seek(const char *param, void *extra_param)
+{
+    char *end;
+    long seconds;
+
+    seconds = strtol(param, &end, 10);
+    if (end == param || *end != '\0' || seconds < 0) {
+        return -1;
+    }
+
+    if (playback_active) {
+        return event_playback_seek((unsigned int)seconds);
+    }
+
+    /* applied once playback has started */
+    seek_requested = 1;
+    seek_requested_second = (unsigned int)seconds;
+
+    return 0;
+}
+
+static int cmdline_seek_bench(const char *param, void *extra_param)
+{
+    seek_bench_requested = 1;
+
+    return event_playback_start();
+}
+
 static const cmdline_option_t cmdline_options[] =
 {
     { "-playback", CALL_FUNCTION, CMDLINE_ATTRIB_NONE,
@@ -1292,6 +1826,24 @@ static const cmdline_option_t cmdline_options[] =
     { "+eventimageinc", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
       NULL, NULL, "EventImageInclude", (resource_value_t)0,
       NULL, "Disable including disk images" },
+    { "-eventkeyframeinterval", SET_RESOURCE, CMDLINE_ATTRIB_NEED_ARGS,
+      NULL, NULL, "EventKeyframeInterval", NULL,
+      "<Seconds>", "Write a keyframe snapshot every <Seconds> seconds while recording (0: off)" },
+    { "-eventconvert", CALL_FUNCTION, CMDLINE_ATTRIB_NONE,
+      cmdline_convert, NULL, NULL, NULL,
+      NULL, "Play back recorded events and add keyframes to the history" },
+    { "-eventkeyframedisks", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
+      NULL, NULL, "EventKeyframeDisks", (resource_value_t)1,
+      NULL, "Include disk images in keyframe snapshots" },
+    { "+eventkeyframedisks", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
+      NULL, NULL, "EventKeyframeDisks", (resource_value_t)0,
+      NULL, "Do not include disk images in keyframe snapshots" },
+    { "-eventseek", CALL_FUNCTION, CMDLINE_ATTRIB_NEED_ARGS,
+      cmdline_seek, NULL, NULL, NULL,
+      "<Seconds>", "Seek to <Seconds> into the recorded events when playing them back" },
+    { "-eventseekbench", CALL_FUNCTION, CMDLINE_ATTRIB_NONE,
+      cmdline_seek_bench, NULL, NULL, NULL,
+      NULL, "Play back recorded events, time seeking to several points and quit playback" },
     CMDLINE_LIST_END
 };
 
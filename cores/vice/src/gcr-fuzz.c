@@ -0,0 +1,366 @@
+/*
+ * gcr-fuzz.c - Randomized round trip and equivalence checks for gcr.c
+ *
+ * Written by
+ *  The Ready authors <ready@tpau.group>
+ *
+ * This file is part of VICE, the Versatile Commodore Emulator.
+ * See README for copyright notice.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA
+ *  02111-1307  USA.
+ *
+ */
+
+/* This is a standalone program, not part of any emulator. It includes gcr.c
+   to get at its static helpers and checks:
+
+   - the 4 byte <-> GCR converters and gcr_find_sync() against the simple
+     bit at a time versions they replaced;
+   - that 1541 tracks built with gcr_convert_sector_to_GCR() read back with
+     gcr_read_sector() and gcr_read_sectors(), at every bit alignment and
+     after gcr_write_sector();
+   - that gcr_read_sectors() gives the same data and errors as calling
+     gcr_read_sector() for each sector, on tracks with bad sectors, flipped
+     bits and missing syncs.
+
+   Build and run it from this directory with
+
+       cc -I. -Iarch/shared -o gcr-fuzz gcr-fuzz.c && ./gcr-fuzz [seed [rounds]]
+
+   It prints the first mismatch and exits with status 1, or exits with
+   status 0 if all checks pass.  */
+
+#include "gcr.c"
+
+/* gcr.c only needs the allocation functions from lib.c */
+void *lib_malloc_pinpoint(size_t size, const char *name, unsigned int line)
+{
+    return malloc(size ? size : 1);
+}
+
+void *lib_calloc_pinpoint(size_t nmemb, size_t size, const char *name, unsigned int line)
+{
+    return calloc(nmemb ? nmemb : 1, size ? size : 1);
+}
+
+void lib_free_pinpoint(void *p, const char *name, unsigned int line)
+{
+    free(p);
+}
+
+/* 1541 speed zones, from the inside out, as in diskimage.c */
+static const unsigned int zone_sectors[4] = { 17, 18, 19, 21 };
+static const unsigned int zone_track_size[4] = { 6250, 6666, 7142, 7692 };
+static const unsigned int zone_gap[4] = { 9, 12, 17, 8 };
+
+#define HEADER_GAP  9
+#define SYNC_SIZE   5
+#define MAX_SECTORS 21
+
+static uint32_t rng_state;
+
+static uint32_t rng(void)
+{
+    /* xorshift32 */
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static unsigned int rng_below(unsigned int n)
+{
+    return rng() % n;
+}
+
+static int failures;
+
+static void fail(const char *what, unsigned int round)
+{
+    printf("gcr-fuzz: %s differs in round %u\n", what, round);
+    failures++;
+}
+
+/* ------------------------------------------------------------------------- */
+/* The previous, bit at a time implementations */
+
+static void ref_convert_4bytes_to_GCR(const uint8_t *source, uint8_t *dest)
+{
+    int i;
+    unsigned int tdest = 0;
+
+    for (i = 2; i < 10; i += 2, source++, dest++) {
+        tdest <<= 5;
+        tdest |= GCR_conv_data[(*source) >> 4];
+        tdest <<= 5;
+        tdest |= GCR_conv_data[(*source) & 0x0f];
+        *dest = (uint8_t)(tdest >> i);
+    }
+    *dest = (uint8_t)tdest;
+}
+
+static void ref_convert_GCR_to_4bytes(const uint8_t *source, uint8_t *dest)
+{
+    int i;
+    uint32_t tdest = *source;
+
+    tdest <<= 13;
+    for (i = 5; i < 13; i += 2, dest++) {
+        source++;
+        tdest |= ((uint32_t)(*source)) << i;
+        *dest = From_GCR_conv_data[(tdest >> 16) & 0x1f] << 4;
+        tdest <<= 5;
+        *dest |= From_GCR_conv_data[(tdest >> 16) & 0x1f];
+        tdest <<= 5;
+    }
+}
+
+static int ref_find_sync(const disk_track_t *raw, int p, int s)
+{
+    unsigned int w;
+    int b;
+
+    if (!raw->data || !raw->size) {
+        return -CBMDOS_FDC_ERR_SYNC;
+    }
+
+    w = 0;
+    b = raw->data[p >> 3] << (p & 7);
+    while (s--) {
+        if (b & 0x80) {
+            w = (w << 1) | 1;
+        } else {
+            if (~w & 0x3ff) {
+                w <<= 1;
+            } else {
+                return p;
+            }
+        }
+        if (~p & 7) {
+            p++;
+            b <<= 1;
+        } else {
+            p++;
+            if (p >= raw->size * 8) {
+                p = 0;
+            }
+            b = raw->data[p >> 3];
+        }
+    }
+    return -CBMDOS_FDC_ERR_SYNC;
+}
+
+/* ------------------------------------------------------------------------- */
+
+static void check_converters(unsigned int round)
+{
+    uint8_t bytes[4], gcr[5], ref[5], back[4], ref_back[4];
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        bytes[i] = (uint8_t)rng();
+    }
+    gcr_convert_4bytes_to_GCR(bytes, gcr);
+    ref_convert_4bytes_to_GCR(bytes, ref);
+    if (memcmp(gcr, ref, 5)) {
+        fail("gcr_convert_4bytes_to_GCR()", round);
+    }
+    gcr_convert_GCR_to_4bytes(gcr, back);
+    if (memcmp(bytes, back, 4)) {
+        fail("4 byte GCR round trip", round);
+    }
+
+    /* Arbitrary, mostly invalid, GCR must decode the same way too */
+    for (i = 0; i < 5; i++) {
+        gcr[i] = (uint8_t)rng();
+    }
+    gcr_convert_GCR_to_4bytes(gcr, back);
+    ref_convert_GCR_to_4bytes(gcr, ref_back);
+    if (memcmp(back, ref_back, 4)) {
+        fail("gcr_convert_GCR_to_4bytes()", round);
+    }
+}
+
+static void check_find_sync(unsigned int round)
+{
+    uint8_t data[64];
+    disk_track_t raw;
+    int i, p, s, bits;
+
+    /* Short tracks, mostly ones, so that syncs of all lengths turn up at all
+       bit positions, including across the end of the track */
+    raw.data = data;
+    raw.size = 1 + rng_below(sizeof(data));
+    for (i = 0; i < raw.size; i++) {
+        data[i] = rng_below(3) ? 0xff : (uint8_t)rng();
+    }
+    bits = raw.size * 8;
+    p = rng_below(bits);
+    s = rng_below(bits * 2 + 16);
+
+    if (gcr_find_sync(&raw, p, s) != ref_find_sync(&raw, p, s)) {
+        fail("gcr_find_sync()", round);
+    }
+}
+
+/* Build a 1541 track the way fsimage_dxx_read_half_track() does */
+static void build_track(disk_track_t *raw, unsigned int zone, unsigned int track,
+                        const uint8_t *data, const fdc_err_t *errors)
+{
+    gcr_header_t header;
+    unsigned int sector;
+    uint8_t *ptr;
+
+    raw->size = zone_track_size[zone];
+    memset(raw->data, 0x55, raw->size);
+
+    header.track = track;
+    header.id1 = 0x41;
+    header.id2 = 0x42;
+    ptr = raw->data;
+    for (sector = 0; sector < zone_sectors[zone]; sector++) {
+        header.sector = sector;
+        gcr_convert_sector_to_GCR(data + sector * 256, ptr, &header, HEADER_GAP,
+                                  SYNC_SIZE, errors[sector]);
+        ptr += SECTOR_GCR_SIZE_WITH_HEADER + HEADER_GAP + zone_gap[zone] + SYNC_SIZE * 2;
+    }
+}
+
+/* Rotate the whole track left by n bits, as if the drive started reading at
+   a different point */
+static void rotate_track(disk_track_t *raw, unsigned int n)
+{
+    uint8_t *copy;
+    unsigned int bits, i, from;
+
+    bits = raw->size * 8;
+    copy = malloc(raw->size);
+    memcpy(copy, raw->data, raw->size);
+    for (i = 0; i < bits; i++) {
+        from = (i + n) % bits;
+        if ((copy[from >> 3] << (from & 7)) & 0x80) {
+            raw->data[i >> 3] |= 0x80 >> (i & 7);
+        } else {
+            raw->data[i >> 3] &= ~(0x80 >> (i & 7));
+        }
+    }
+    free(copy);
+}
+
+/* Compare gcr_read_sectors() with gcr_read_sector() called per sector, and
+   return the number of sectors that did not read back as expected */
+static unsigned int read_track(const disk_track_t *raw, unsigned int sectors,
+                               const uint8_t *expected, unsigned int round)
+{
+    uint8_t data[MAX_SECTORS * 256], one[256];
+    fdc_err_t errors[MAX_SECTORS], error;
+    unsigned int sector, bad = 0;
+
+    memset(data, 0, sizeof(data));
+    gcr_read_sectors(raw, data, sectors, errors);
+
+    for (sector = 0; sector < sectors; sector++) {
+        memset(one, 0, sizeof(one));
+        error = gcr_read_sector(raw, one, (uint8_t)sector);
+        if (error != errors[sector]) {
+            fail("gcr_read_sectors() error code", round);
+        } else if (memcmp(one, data + sector * 256, 256)) {
+            fail("gcr_read_sectors() data", round);
+        }
+        if (error != CBMDOS_FDC_ERR_OK || memcmp(one, expected + sector * 256, 256)) {
+            bad++;
+        }
+    }
+    return bad;
+}
+
+static void check_track(unsigned int round)
+{
+    static uint8_t track_data[NUM_MAX_BYTES_TRACK];
+    uint8_t data[MAX_SECTORS * 256], sector_data[256];
+    fdc_err_t errors[MAX_SECTORS];
+    disk_track_t raw;
+    unsigned int zone, sectors, sector, i, flips;
+
+    zone = rng_below(4);
+    sectors = zone_sectors[zone];
+    for (i = 0; i < sectors * 256; i++) {
+        data[i] = (uint8_t)rng();
+    }
+    for (sector = 0; sector < sectors; sector++) {
+        errors[sector] = CBMDOS_FDC_ERR_OK;
+    }
+
+    /* A clean track reads back at every alignment */
+    raw.data = track_data;
+    build_track(&raw, zone, 1 + rng_below(35), data, errors);
+    rotate_track(&raw, rng_below(raw.size * 8));
+    if (read_track(&raw, sectors, data, round)) {
+        fail("clean track round trip", round);
+    }
+
+    /* A sector written back replaces the old data */
+    sector = rng_below(sectors);
+    for (i = 0; i < 256; i++) {
+        sector_data[i] = (uint8_t)rng();
+    }
+    if (gcr_write_sector(&raw, sector_data, (uint8_t)sector) != CBMDOS_FDC_ERR_OK) {
+        fail("gcr_write_sector() result", round);
+    }
+    memcpy(data + sector * 256, sector_data, 256);
+    if (read_track(&raw, sectors, data, round)) {
+        fail("written sector round trip", round);
+    }
+
+    /* With damage, only the two readers have to agree */
+    for (sector = 0; sector < sectors; sector++) {
+        errors[sector] = rng_below(4) ? CBMDOS_FDC_ERR_OK : (fdc_err_t)(2 + rng_below(10));
+    }
+    build_track(&raw, zone, 1 + rng_below(35), data, errors);
+    flips = rng_below(8);
+    for (i = 0; i < flips; i++) {
+        raw.data[rng_below(raw.size)] ^= (uint8_t)(1 << rng_below(8));
+    }
+    rotate_track(&raw, rng_below(raw.size * 8));
+    read_track(&raw, sectors, data, round);
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int round, rounds;
+
+    rng_state = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 1;
+    if (rng_state == 0) {
+        rng_state = 1;
+    }
+    rounds = (argc > 2) ? (unsigned int)strtoul(argv[2], NULL, 0) : 2000;
+
+    for (round = 0; round < rounds && failures < 10; round++) {
+        unsigned int i;
+
+        for (i = 0; i < 100; i++) {
+            check_converters(round);
+            check_find_sync(round);
+        }
+        check_track(round);
+    }
+
+    if (failures) {
+        return 1;
+    }
+    printf("gcr-fuzz: %u rounds passed\n", rounds);
+    return 0;
+}
@@ -65,47 +65,81 @@ static const uint8_t From_GCR_conv_data[32] =
 };
 
 
-static void gcr_convert_4bytes_to_GCR(const uint8_t *source, uint8_t *dest)
+/* Number of consecutive 1 bits at the top and at the bottom of a byte, used
+   to scan for SYNC marks a whole byte at a time */
+static const uint8_t gcr_leading_ones[256] =
 {
-    int i;
-    register unsigned int tdest = 0;    /* at least 16 bits for overflow shifting */
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+    4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 7, 8
+};
 
-    for (i = 2; i < 10; i += 2, source++, dest++)
-    {
-        tdest <<= 5;  /* make room for the upper nybble */
-        tdest |= GCR_conv_data[(*source) >> 4];
+static const uint8_t gcr_trailing_ones[256] =
+{
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 6,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 7,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 6,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 5,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 4,
+    0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0, 8
+};
 
-        tdest <<= 5;  /* make room for the lower nybble */
-        tdest |= GCR_conv_data[(*source) & 0x0f];
+/* The 4 bytes are assembled into one 40 bit word of 8 quintets and stored
+   with plain byte extracts, instead of shifting the output one nybble at a
+   time. */
+static void gcr_convert_4bytes_to_GCR(const uint8_t *source, uint8_t *dest)
+{
+    int i;
+    uint64_t tdest = 0;
 
-        *dest = (uint8_t)(tdest >> i);
+    for (i = 0; i < 4; i++) {
+        tdest = (tdest << 10)
+                | ((uint64_t)GCR_conv_data[source[i] >> 4] << 5)
+                | GCR_conv_data[source[i] & 0x0f];
     }
 
-    *dest = (uint8_t)tdest;
+    dest[0] = (uint8_t)(tdest >> 32);
+    dest[1] = (uint8_t)(tdest >> 24);
+    dest[2] = (uint8_t)(tdest >> 16);
+    dest[3] = (uint8_t)(tdest >> 8);
+    dest[4] = (uint8_t)tdest;
 }
 
 static void gcr_convert_GCR_to_4bytes(const uint8_t *source, uint8_t *dest)
 {
     int i;
-    /* at least 24 bits for shifting into bits 16...20 */
-    register uint32_t tdest = *source;
+    uint64_t tsource;
 
-    tdest <<= 13;
+    tsource = ((uint64_t)source[0] << 32) | ((uint64_t)source[1] << 24)
+              | ((uint32_t)source[2] << 16) | ((uint32_t)source[3] << 8)
+              | source[4];
 
-    for (i = 5; i < 13; i += 2, dest++)
-    {
-        source++;
-        tdest |= ((uint32_t)(*source)) << i;
-
-        /*  "tdest >> 16" could be optimized to a word
-         *  aligned access, hopefully the compiler does
-         *  this for us (in a portable way)
-         */
-        *dest = From_GCR_conv_data[(tdest >> 16) & 0x1f] << 4;
-        tdest <<= 5;
-
-        *dest |= From_GCR_conv_data[(tdest >> 16) & 0x1f];
-        tdest <<= 5;
+    for (i = 0; i < 4; i++) {
+        dest[i] = (From_GCR_conv_data[(tsource >> (35 - i * 10)) & 0x1f] << 4)
+                  | From_GCR_conv_data[(tsource >> (30 - i * 10)) & 0x1f];
     }
 }
 
@@ -167,36 +201,48 @@ void gcr_convert_sector_to_GCR(const uint8_t *buffer, uint8_t *data, const gcr_h
     gcr_convert_4bytes_to_GCR(buf, data);
 }
 
+/* Returns the bit position of the first 0 bit following at least 10 set bits,
+   scanning at most s bits starting at p. Bits are examined one at a time only
+   up to the next byte boundary, after that whole bytes are handled using the
+   leading/trailing ones tables. */
 static int gcr_find_sync(const disk_track_t *raw, int p, int s)
 {
-    unsigned int w;
-    int b;
+    int ones, lead;
+    uint8_t b;
 
     if (!raw->data || !raw->size) {
         return -CBMDOS_FDC_ERR_SYNC;
     }
 
-    w = 0;
-    b = raw->data[p >> 3] << (p & 7);
-    while (s--) {
-        if (b & 0x80) {
-            w = (w << 1) | 1;
+    ones = 0;
+    while (s > 0) {
+        b = raw->data[p >> 3];
+        if (!(p & 7) && s >= 8) {
+            lead = gcr_leading_ones[b];
+            if (lead < 8) {
+                if (ones + lead >= 10) {
+                    return p + lead;
+                }
+                ones = gcr_trailing_ones[b];
+            } else if (ones < 10) {
+                ones += 8;
+            }
+            p += 8;
+            s -= 8;
         } else {
-            if (~w & 0x3ff) {
-                w <<= 1;
+            if ((b << (p & 7)) & 0x80) {
+                ones++;
             } else {
-                return p;
+                if (ones >= 10) {
+                    return p;
+                }
+                ones = 0;
             }
-        }
-        if (~p & 7) {
-            p++;
-            b <<= 1;
-        } else {
             p++;
-            if (p >= raw->size * 8) {
-                p = 0;
-            }
-            b = raw->data[p >> 3];
+            s--;
+        }
+        if (p >= raw->size * 8) {
+            p = 0;
         }
     }
     return -CBMDOS_FDC_ERR_SYNC;
@@ -260,16 +306,12 @@ static int gcr_find_sector_header(const disk_track_t *raw, uint8_t sector)
     return -CBMDOS_FDC_ERR_HEADER;
 }
 
-fdc_err_t gcr_read_sector(const disk_track_t *raw, uint8_t *data, uint8_t sector)
+/* Decode the data block belonging to the header found at bit position p */
+static fdc_err_t gcr_read_sector_data(const disk_track_t *raw, uint8_t *data, int p)
 {
     uint8_t buffer[260];
     uint8_t b;
-    int i, p;
-
-    p = gcr_find_sector_header(raw, sector);
-    if (p < 0) {
-        return -p;
-    }
+    int i;
 
     p = gcr_find_sync(raw, p, 500 * 8);
     if (p < 0) {
@@ -291,6 +333,67 @@ fdc_err_t gcr_read_sector(const disk_track_t *raw, uint8_t *data, uint8_t sector
     return b ? CBMDOS_FDC_ERR_DCHECK : CBMDOS_FDC_ERR_OK;
 }
 
+fdc_err_t gcr_read_sector(const disk_track_t *raw, uint8_t *data, uint8_t sector)
+{
+    int p;
+
+    p = gcr_find_sector_header(raw, sector);
+    if (p < 0) {
+        return -p;
+    }
+
+    return gcr_read_sector_data(raw, data, p);
+}
+
+/* Read sectors 0 to sectors-1 of a track into data (256 bytes each) and store
+   the result of each sector in errors. This gives the same results as calling
+   gcr_read_sector() for every sector, but the headers are located in a single
+   pass over the track instead of rescanning it from the start each time. */
+void gcr_read_sectors(const disk_track_t *raw, uint8_t *data, unsigned int sectors, fdc_err_t *errors)
+{
+    uint8_t header[4];
+    int *pos;
+    int p, p2;
+    unsigned int sector, found = 0;
+
+    if (sectors == 0) {
+        return;
+    }
+
+    pos = lib_malloc(sectors * sizeof(int));
+    for (sector = 0; sector < sectors; sector++) {
+        pos[sector] = -1;
+    }
+
+    p = 0;
+    p2 = -CBMDOS_FDC_ERR_SYNC;
+    while (found < sectors) {
+        p = gcr_find_sync(raw, p, raw->size * 8);
+        if (p2 == p) {
+            break;
+        }
+        if (p2 < 0) {
+            p2 = p;
+        }
+        gcr_decode_block(raw, p, header, 1);
+
+        if (header[0] == 0x08 && header[2] < sectors && pos[header[2]] < 0) {
+            pos[header[2]] = p;
+            found++;
+        }
+    }
+
+    for (sector = 0; sector < sectors; sector++, data += 256) {
+        if (pos[sector] >= 0) {
+            errors[sector] = gcr_read_sector_data(raw, data, pos[sector]);
+        } else {
+            errors[sector] = (p2 < 0) ? -p2 : CBMDOS_FDC_ERR_HEADER;
+        }
+    }
+
+    lib_free(pos);
+}
+
 fdc_err_t gcr_write_sector(disk_track_t *raw, const uint8_t *data, uint8_t sector)
 {
     uint8_t buffer[260], *offset, *buf;
@@ -56,6 +56,13 @@ typedef struct disk_track_s {
 typedef struct gcr_s {
     /* Raw GCR image of the disk.  */
     disk_track_t tracks[MAX_GCR_TRACKS];
+    /* Half tracks that still have to be converted from the attached sector
+       based image, see disk_image_read_half_track().  */
+    uint8_t pending[MAX_GCR_TRACKS];
+    /* Disk IDs of both sides when the tracks were marked pending, so that
+       tracks converted later match the ones converted already.  */
+    uint8_t pending_id[2][2];
+    int pending_double_sided;
 } gcr_t;
 
 typedef struct gcr_header_s {
@@ -65,6 +72,8 @@ typedef struct gcr_header_s {
 extern void gcr_convert_sector_to_GCR(const uint8_t *buffer, uint8_t *ptr, const gcr_header_t *header,
                                       int gap, int sync, enum fdc_err_e error_code);
 extern enum fdc_err_e gcr_read_sector(const disk_track_t *raw, uint8_t *data, uint8_t sector);
+extern void gcr_read_sectors(const disk_track_t *raw, uint8_t *data, unsigned int sectors,
+                             enum fdc_err_e *errors);
 extern enum fdc_err_e gcr_write_sector(disk_track_t *raw, const uint8_t *data, uint8_t sector);
 
 extern gcr_t *gcr_create_image(void);
@@ -405,6 +405,7 @@ void P64PulseStreamCreate(PP64PulseStream Instance) {
     Instance->UsedLast = -1;
     Instance->FreeList = -1;
     Instance->CurrentIndex = -1;
+    Instance->Sorted = 1;
 }
 
 void P64PulseStreamDestroy(PP64PulseStream Instance) {
@@ -423,6 +424,7 @@ void P64PulseStreamClear(PP64PulseStream Instance) {
     Instance->UsedLast = -1;
     Instance->FreeList = -1;
     Instance->CurrentIndex = -1;
+    Instance->Sorted = 1;
 }
 
 p64_int32_t P64PulseStreamAllocatePulse(PP64PulseStream Instance) {
@@ -470,6 +472,7 @@ void P64PulseStreamFreePulse(PP64PulseStream Instance, p64_int32_t Index) {
     Instance->Pulses[Index].Previous = -1;
     Instance->Pulses[Index].Next = Instance->FreeList;
     Instance->FreeList = Index;
+    Instance->Sorted = 0;
 }
 
 void P64PulseStreamAddPulse(PP64PulseStream Instance, p64_uint32_t Position, p64_uint32_t Strength) {
@@ -502,6 +505,7 @@ void P64PulseStreamAddPulse(PP64PulseStream Instance, p64_uint32_t Position, p64
             Index = Current;
         } else {
             Index = P64PulseStreamAllocatePulse(Instance);
+            Instance->Sorted = 0;
             Instance->Pulses[Index].Previous = Instance->Pulses[Current].Previous;
             Instance->Pulses[Index].Next = Current;
             Instance->Pulses[Current].Previous = Index;
@@ -660,6 +664,32 @@ void P64PulseStreamSeek(PP64PulseStream Instance, p64_uint32_t Position) {
     Instance->CurrentIndex = Current;
 }
 
+/* Returns the index of the first pulse at or after Position within the current
+   rotation, or -1 if there is none. Streams that were only appended to (like
+   freshly decoded ones) are searched with a binary search over the pulse
+   array, otherwise the list is walked from the start. */
+p64_int32_t P64PulseStreamFindPulse(PP64PulseStream Instance, p64_uint32_t Position) {
+    p64_int32_t Current, Low, High, Middle;
+    if(Instance->Sorted) {
+        Low = 0;
+        High = (p64_int32_t)Instance->PulsesCount;
+        while(Low < High) {
+            Middle = Low + ((High - Low) >> 1);
+            if(Instance->Pulses[Middle].Position < Position) {
+                Low = Middle + 1;
+            } else {
+                High = Middle;
+            }
+        }
+        return (Low < (p64_int32_t)Instance->PulsesCount) ? Low : -1;
+    }
+    Current = Instance->UsedFirst;
+    while((Current >= 0) && (Instance->Pulses[Current].Position < Position)) {
+        Current = Instance->Pulses[Current].Next;
+    }
+    return Current;
+}
+
 void P64PulseStreamConvertFromGCR(PP64PulseStream Instance, p64_uint8_t* Bytes, p64_uint32_t Len) {
     p64_uint32_t PositionHi, PositionLo, IncrementHi, IncrementLo, BitStreamPosition;
     P64PulseStreamClear(Instance);
@@ -782,6 +812,7 @@ p64_uint32_t P64PulseStreamReadFromStream(PP64PulseStream Instance, PP64MemorySt
     PP64RangeCoderProbabilities RangeCoderProbabilities;
     p64_uint32_t RangeCoderProbabilityOffsets[ProbabilityModelCount];
     p64_uint32_t RangeCoderProbabilityStates[ProbabilityModelCount];
+    p64_uint8_t RangeCoderContextsReset[ModelPositionFlag][256]; /* byte models 0..7 */
     TP64RangeCoder RangeCoderInstance;
     p64_uint32_t ProbabilityCount, Index, Count, DeltaPosition, Position, Strength, result, CountPulses, Size;
     p64_uint8_t *Buffer;
@@ -804,8 +835,14 @@ p64_uint32_t P64PulseStreamReadFromStream(PP64PulseStream Instance, PP64MemorySt
                     ProbabilityCount += ProbabilityCounts[Index];
                     RangeCoderProbabilityStates[Index] = 0;
                 }
+                /* The byte models have 256 contexts of 256 probabilities
+                   each, selected by the previous byte. Only few of them are
+                   used by a stream, so each context is reset on its first
+                   use instead of resetting all 2 MB up front. */
                 RangeCoderProbabilities = P64RangeCoderProbabilitiesAllocate(ProbabilityCount);
-                P64RangeCoderProbabilitiesReset(RangeCoderProbabilities, ProbabilityCount);
+                P64RangeCoderProbabilitiesReset(RangeCoderProbabilities + RangeCoderProbabilityOffsets[ModelPositionFlag], ProbabilityCounts[ModelPositionFlag]);
+                P64RangeCoderProbabilitiesReset(RangeCoderProbabilities + RangeCoderProbabilityOffsets[ModelStrengthFlag], ProbabilityCounts[ModelStrengthFlag]);
+                memset(RangeCoderContextsReset, 0, sizeof(RangeCoderContextsReset));
 
                 memset(&RangeCoderInstance, 0, sizeof(TP64RangeCoder));
                 P64RangeCoderInit(&RangeCoderInstance);
@@ -815,6 +852,17 @@ p64_uint32_t P64PulseStreamReadFromStream(PP64PulseStream Instance, PP64MemorySt
                 RangeCoderInstance.BufferPosition = 0;
                 P64RangeCoderStart(&RangeCoderInstance);
 
+                /* Allocate all pulses at once, instead of growing the array
+                   while decoding */
+                if((CountPulses > Instance->PulsesAllocated) && (CountPulses <= P64PulseSamplesPerRotation)) {
+                    Instance->PulsesAllocated = CountPulses;
+                    if(Instance->Pulses) {
+                        Instance->Pulses = p64_realloc(Instance->Pulses, Instance->PulsesAllocated * sizeof(TP64Pulse));
+                    } else {
+                        Instance->Pulses = p64_malloc(Instance->PulsesAllocated * sizeof(TP64Pulse));
+                    }
+                }
+
                 Count = 0;
 
                 Position = 0;
@@ -830,6 +878,10 @@ p64_uint32_t P64PulseStreamReadFromStream(PP64PulseStream Instance, PP64MemorySt
             p64_int32_t Bit; \
                       result = 0; \
                       for (ByteIndex = 0; ByteIndex < 4; ByteIndex++) { \
+                          if(!RangeCoderContextsReset[Model + ByteIndex][RangeCoderProbabilityStates[Model + ByteIndex]]) { \
+                              RangeCoderContextsReset[Model + ByteIndex][RangeCoderProbabilityStates[Model + ByteIndex]] = 1; \
+                              P64RangeCoderProbabilitiesReset(RangeCoderProbabilities + (RangeCoderProbabilityOffsets[Model + ByteIndex] + (RangeCoderProbabilityStates[Model + ByteIndex] << 8)), 256); \
+                          } \
                           Context = 1; \
                           for (Bit = 7; Bit >= 0; Bit--) { \
                               Context = (Context << 1) | P64RangeCoderDecodeBit(&RangeCoderInstance, RangeCoderProbabilities + (RangeCoderProbabilityOffsets[Model + ByteIndex] + (((RangeCoderProbabilityStates[Model + ByteIndex] << 8) | Context) & 0xffffUL)), 4); \
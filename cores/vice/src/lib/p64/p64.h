@@ -107,6 +107,7 @@ typedef struct {
 	p64_int32_t UsedLast;
 	p64_int32_t FreeList;
 	p64_int32_t CurrentIndex;
+	p64_uint32_t Sorted; /* Pulses[0..PulsesCount-1] are in list order, see P64PulseStreamFindPulse */
 } TP64PulseStream;
 
 typedef TP64PulseStream* PP64PulseStream;
@@ -163,6 +164,7 @@ extern p64_uint32_t P64PulseStreamGetPulseCount(PP64PulseStream Instance);
 extern p64_uint32_t P64PulseStreamGetPulse(PP64PulseStream Instance, p64_uint32_t Position);
 extern void P64PulseStreamSetPulse(PP64PulseStream Instance, p64_uint32_t Position, p64_uint32_t Strength);
 extern void P64PulseStreamSeek(PP64PulseStream Instance, p64_uint32_t Position);
+extern p64_int32_t P64PulseStreamFindPulse(PP64PulseStream Instance, p64_uint32_t Position);
 extern void P64PulseStreamConvertFromGCR(PP64PulseStream Instance, p64_uint8_t* Bytes, p64_uint32_t Len);
 extern void P64PulseStreamConvertToGCR(PP64PulseStream Instance, p64_uint8_t* Bytes, p64_uint32_t Len);
 extern p64_uint32_t P64PulseStreamConvertToGCRWithLogic(PP64PulseStream Instance, p64_uint8_t* Bytes, p64_uint32_t Len, p64_uint32_t SpeedZone);
@@ -34,7 +34,6 @@
 #include "raster-cache-fill-1fff.h"
 #include "raster-cache-nibbles.h"
 #include "raster-cache-text-ext.h"
-#include "raster-cache-text-std.h"
 #include "raster-cache.h"
 #include "raster-modes.h"
 #include "ted-draw.h"
@@ -105,19 +104,29 @@ static uint8_t *const aligned_line_buffer = (uint8_t *)_aligned_line_buffer;
 
 /*-----------------------------------------------------------------------*/
 
+/* Return the pixel byte displayed for character `c' with color `col', after
+   applying reverse, flashing and the hardware cursor exactly like
+   `_draw_std_text()' does, so that it can be used as the cache key.  */
 inline static uint8_t get_char_data(uint8_t c, uint8_t col, int l, uint8_t *char_mem,
                                  int bytes_per_char, int curpos, int index)
 {
     uint8_t data;
 
-    if ((col & 0x80) && (!ted.cursor_visible)) {
-        data = 0;
-    } else {
-        if (!ted.reverse_mode && (c & 0x80)) {
-            data = char_mem[((c & 0x7f) * bytes_per_char) + (l)] ^ 0xff;
+    if (ted.reverse_mode) {
+        if ((col & 0x80) && (!ted.cursor_visible)) {
+            data = 0;
         } else {
             data = char_mem[((c) * bytes_per_char) + (l)];
         }
+    } else {
+        if ((col & 0x80) && (!ted.cursor_visible)) {
+            data = 0;
+        } else {
+            data = char_mem[((c & 0x7f) * bytes_per_char) + (l)];
+        }
+        if (c & 0x80) {
+            data ^= 0xff;
+        }
     }
 
 
@@ -180,9 +189,6 @@ inline static int cache_data_fill_text(uint8_t *dest,
 
 /*-----------------------------------------------------------------------*/
 
-/* FIXME: in the cache, we store the foreground bitmap values for the
-   characters, but we do not use them when drawing and this is slow!  */
-
 /* Standard text mode.  */
 
 static int get_std_text(raster_cache_t *cache, unsigned int *xs,
@@ -219,14 +225,6 @@ static int get_std_text(raster_cache_t *cache, unsigned int *xs,
                                 TED_SCREEN_TEXTCOLS,
                                 xs, xe,
                                 rr);
-    r |= raster_cache_data_fill(cache->color_data_2,
-                                ted.vbuf,
-                                TED_SCREEN_TEXTCOLS,
-                                xs, xe,
-                                rr);
-
-
-
     return r;
 }
 
@@ -295,24 +293,17 @@ inline static void _draw_std_text_cached(uint8_t *p, unsigned int xs,
                                          raster_cache_t *cache)
 {
     uint32_t *table_ptr;
-    uint8_t *foreground_data, *color_data, *vbuf;
+    uint8_t *foreground_data, *color_data;
     unsigned int i;
 
     table_ptr = hr_table + (cache->background_data[0] << 4);
-    foreground_data = cache->foreground_data; /* contains both vbuf and cbuf */
+    foreground_data = cache->foreground_data; /* final pixels, see get_char_data() */
     color_data = cache->color_data_1;
-    vbuf = cache->color_data_2;
 
     for (i = xs; i <= xe; i++) {
-        int d;
+        int d = foreground_data[i];
         uint32_t *ptr = table_ptr + ((color_data[i] & 0x7f) << 11);
 
-        if ((color_data[i] & 0x80) && (!ted.cursor_visible)) {
-            d = (vbuf[i] & 0x80 ? 0xff : 0x00);
-        } else {
-            d = foreground_data[i];
-        }
-
         *((uint32_t *)p + i * 2) = *(ptr + (d >> 4));
         *((uint32_t *)p + i * 2 + 1) = *(ptr + (d & 0xf));
     }
@@ -433,6 +424,12 @@ static int get_hires_bitmap(raster_cache_t *cache, unsigned int *xs,
                                      TED_SCREEN_TEXTCOLS,
                                      xs, xe,
                                      rr);
+
+    /* Overscan color in HIRES is determined by last char of previous line.
+       Update it here, as the drawing function is skipped for unchanged
+       lines.  */
+    ted.raster.idle_background_color = ted.vbuf[TED_SCREEN_TEXTCOLS - 1] & 0x7f;
+
     return r;
 }
 
@@ -471,11 +468,6 @@ static void draw_hires_bitmap_cached(raster_cache_t *cache, unsigned int xs,
                                      unsigned int xe)
 {
     ALIGN_DRAW_FUNC(_draw_hires_bitmap, xs, xe);
-
-    /* Overscan color in HIRES is determined by last char of previous line */
-    if (xe == TED_SCREEN_TEXTCOLS - 1) {
-        ted.raster.idle_background_color = ted.vbuf[TED_SCREEN_TEXTCOLS - 1] & 0x7f;
-    }
 }
 
 static void draw_hires_bitmap_foreground(unsigned int start_char,
@@ -491,25 +483,37 @@ static void draw_hires_bitmap_foreground(unsigned int start_char,
 static int get_mc_text(raster_cache_t *cache, unsigned int *xs,
                        unsigned int *xe, int rr)
 {
+    uint8_t char_data[TED_SCREEN_TEXTCOLS];
+    uint8_t *char_ptr;
+    uint8_t mask;
+    unsigned int i;
     int r;
 
     if (ted.raster.background_color != cache->background_data[0]
         || cache->color_data_1[0] != ted.ext_background_color[0]
         || cache->color_data_1[1] != ted.ext_background_color[1]
+        || cache->color_data_1[2] != (uint8_t)ted.reverse_mode
         || cache->chargen_ptr != ted.chargen_ptr) {
         cache->background_data[0] = ted.raster.background_color;
         cache->color_data_1[0] = ted.ext_background_color[0];
         cache->color_data_1[1] = ted.ext_background_color[1];
+        cache->color_data_1[2] = (uint8_t)ted.reverse_mode;
         cache->chargen_ptr = ted.chargen_ptr;
         rr = 1;
     }
 
-    r = raster_cache_data_fill_text(cache->foreground_data,
-                                    ted.vbuf,
-                                    ted.chargen_ptr + ted.raster.ycounter,
-                                    TED_SCREEN_TEXTCOLS,
-                                    xs, xe,
-                                    rr);
+    /* Key on the character data `_draw_mc_text()' actually fetches.  */
+    char_ptr = ted.chargen_ptr + ted.raster.ycounter;
+    mask = ted.reverse_mode ? 0xff : 0x7f;
+    for (i = 0; i < TED_SCREEN_TEXTCOLS; i++) {
+        char_data[i] = char_ptr[(ted.vbuf[i] & mask) * 8];
+    }
+
+    r = raster_cache_data_fill(cache->foreground_data,
+                               char_data,
+                               TED_SCREEN_TEXTCOLS,
+                               xs, xe,
+                               rr);
     r |= raster_cache_data_fill(cache->color_data_3,
                                 ted.cbuf,
                                 TED_SCREEN_TEXTCOLS,
@@ -891,8 +895,10 @@ static int get_idle(raster_cache_t *cache, unsigned int *xs, unsigned int *xe,
 {
     if (rr
         || ted.raster.background_color != cache->color_data_1[0]
+        || ted.raster.blank_enabled != cache->color_data_1[1]
         || ted.idle_data != cache->foreground_data[0]) {
         cache->color_data_1[0] = ted.raster.background_color;
+        cache->color_data_1[1] = (uint8_t)ted.raster.blank_enabled;
         cache->foreground_data[0] = (uint8_t)ted.idle_data;
         *xs = 0;
         *xe = TED_SCREEN_TEXTCOLS - 1;
@@ -64,13 +64,15 @@ static int set_video_cache_enabled(int val, void *param)
             val = 1;
         }
 #endif
-        /* we will remove the video cache alltogether in the future, so disable
-           it by default, for all machines */
+        /* the TED cache has no frame comparison against the uncached
+           drawing yet, so it is only used when requested explicitly */
         val = 0;
     }
 
-    /* no more video cache support */
-    val = 0;
+    /* no more video cache support for the other chips */
+    if (machine_class != VICE_MACHINE_PLUS4) {
+        val = 0;
+    }
 
     if (val >= 0) {
         raster_resource_chip->video_cache_enabled = val;
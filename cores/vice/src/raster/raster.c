@@ -509,10 +509,10 @@ void raster_skip_frame(raster_t *raster, int skip)
 
 void raster_enable_cache(raster_t *raster, int enable)
 {
-#if 0 /* disabled cache hack */
-    raster->cache_enabled = enable;
-    raster_force_repaint(raster);
-#endif
+    if (raster->cache_enabled != enable) {
+        raster->cache_enabled = enable;
+        raster_force_repaint(raster);
+    }
 }
 
 void raster_set_canvas_refresh(raster_t *raster, int enable)
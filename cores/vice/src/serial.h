@@ -41,6 +41,7 @@
 
 struct cbmdos_cmd_parse_s;
 struct disk_image_s;
+struct snapshot_s;
 struct trap_s;
 struct vdrive_s;
 
@@ -86,10 +87,13 @@ extern int serial_trap_attention(void);
 extern int serial_trap_send(void);
 extern int serial_trap_receive(void);
 extern int serial_trap_ready(void);
+extern int serial_trap_load(void);
 extern void serial_traps_reset(void);
 extern void serial_trap_eof_callback_set(void (*func)(void));
 extern void serial_trap_attention_callback_set(void (*func)(void));
 extern void serial_trap_truedrive_set(unsigned int flag);
+extern int serial_trap_snapshot_write_module(struct snapshot_s *s);
+extern int serial_trap_snapshot_read_module(struct snapshot_s *s);
 
 extern int serial_realdevice_enable(void);
 extern void serial_realdevice_disable(void);
@@ -28,14 +28,23 @@
 
 #include <stdio.h>
 
+#include "attach.h"
+#include "cmdline.h"
+#include "drive.h"
+#include "drivetypes.h"
+#include "log.h"
 #include "maincpu.h"
 #include "mem.h"
+#include "resources.h"
 #include "serial-iec-bus.h"
 /* Will be removed once serial.c is clean */
 #include "serial-iec-device.h"
 #include "serial-trap.h"
 #include "serial.h"
+#include "snapshot.h"
 #include "types.h"
+#include "vdrive-iec.h"
+#include "vdrive.h"
 
 
 /* Warning: these are only valid for the VIC20, C64 and C128, but *not* for
@@ -67,6 +76,30 @@ static void (*attention_callback_func)(void);
 
 static unsigned int serial_truedrive;
 
+/* Flag: Load files directly from the images attached to true drives?  */
+static int serial_fastload_enabled;
+
+/* Per unit flag, set when the true drive got a command that may run custom
+   code in the drive (M-W, M-E, B-E, U3-U8). From then on the drive is left
+   alone until the next reset.  */
+static int custom_drive_code[NUM_DISK_UNITS];
+
+/* First bytes of the command currently sent to the command channel of a
+   true drive.  */
+static uint8_t drive_command[3];
+static unsigned int drive_command_len;
+
+/* Kernal zero page locations used by the LOAD trap, valid for the VIC20 and
+   the C64.  */
+#define KERNAL_STATUS   0x90
+#define KERNAL_VERIFY   0x93
+#define KERNAL_EAL      0xae
+#define KERNAL_FNLEN    0xb7
+#define KERNAL_SA       0xb9
+#define KERNAL_FA       0xba
+#define KERNAL_FNADR    0xbb
+#define KERNAL_MEMUSS   0xc3
+
 #define IS_PRINTER(d)   (((d) & DEVNR_MASK) >= 4 && ((d) & DEVNR_MASK) <= 7)
 
 static void serial_set_st(uint8_t st)
@@ -112,6 +145,11 @@ int serial_trap_attention(void)
             /* Set TrapDevice even if the trap is not taken; needed
                for other traps.  */
             TrapDevice = b;
+        } else if (((b & 0xf0) == SECONDARY) || ((b & 0xf0) == OPEN)) {
+            /* Watch what is sent to the command channel, see
+               serial_trap_send().  */
+            TrapSecondary = b;
+            drive_command_len = 0;
         }
         return 0;
     }
@@ -157,12 +195,41 @@ int serial_trap_attention(void)
     return 1;
 }
 
+/* Remember if a command that runs code in the drive is sent to a true drive,
+   so that serial_trap_load() does not bypass the drive anymore.  */
+static void serial_check_drive_command(uint8_t data)
+{
+    unsigned int unit = TrapDevice & DEVNR_MASK;
+
+    if (!serial_fastload_enabled
+        || (TrapDevice & 0xf0) != LISTEN || (TrapSecondary & SA_MASK) != 15
+        || unit < DRIVE_UNIT_MIN || unit > DRIVE_UNIT_MAX
+        || drive_command_len >= sizeof(drive_command)) {
+        return;
+    }
+
+    drive_command[drive_command_len++] = data;
+
+    if ((drive_command_len == 2 && drive_command[0] == 'U'
+         && ((drive_command[1] >= '3' && drive_command[1] <= '8')
+             || (drive_command[1] >= 'C' && drive_command[1] <= 'H')))
+        || (drive_command_len == 3 && drive_command[1] == '-'
+            && ((drive_command[0] == 'M' && (drive_command[2] == 'W' || drive_command[2] == 'E'))
+                || (drive_command[0] == 'B' && drive_command[2] == 'E')))) {
+        if (!custom_drive_code[unit - DRIVE_UNIT_MIN]) {
+            log_message(LOG_DEFAULT, "Serial: custom code for drive %u, fast load disabled until reset.", unit);
+        }
+        custom_drive_code[unit - DRIVE_UNIT_MIN] = 1;
+    }
+}
+
 /* Send one byte on the serial bus.  */
 int serial_trap_send(void)
 {
     uint8_t data;
 
     if (serial_truedrive && !IS_PRINTER(TrapDevice)) {
+        serial_check_drive_command(mem_read(BSOUR));
         return 0;
     }
 
@@ -236,15 +303,140 @@ int serial_trap_ready(void)
     return 1;
 }
 
+/* Kernal LOAD from a serial device, called after the "SEARCHING FOR"
+   message. If DriveFastLoad is enabled and the device is a true drive that
+   is idle and has not been given custom code, the file is read through the
+   virtual drive from the same image and copied straight into memory. The
+   true drive is not involved, so its head, motor and LED are left as they
+   are. The Kernal continues with the end of LOAD (resume address) with
+   $AE/$AF pointing behind the loaded data, so "LOADING" is not printed.
+
+   In every other case, including a file that is not found, the normal
+   Kernal code talks to the true drive.  */
+int serial_trap_load(void)
+{
+    uint8_t name[256], data;
+    unsigned int unit, length, i, sa;
+    uint16_t addr, name_addr;
+    uint8_t st = 0;
+    int verify, status;
+    drive_t *drive;
+    vdrive_t *vdrive;
+
+    if (!serial_fastload_enabled || !serial_truedrive) {
+        return 0;
+    }
+
+    unit = mem_read(KERNAL_FA);
+    if (unit < DRIVE_UNIT_MIN || unit > DRIVE_UNIT_MAX
+        || custom_drive_code[unit - DRIVE_UNIT_MIN]
+        || diskunit_context[unit - DRIVE_UNIT_MIN]->type == DRIVE_TYPE_NONE) {
+        return 0;
+    }
+
+    drive = diskunit_context[unit - DRIVE_UNIT_MIN]->drives[0];
+    if (drive->image == NULL || (drive->byte_ready_active & BRA_MOTOR_ON)) {
+        return 0;
+    }
+
+    vdrive = file_system_get_vdrive(unit, 0);
+    if (vdrive == NULL || vdrive->image != drive->image) {
+        return 0;
+    }
+
+    length = mem_read(KERNAL_FNLEN);
+    name_addr = (uint16_t)(mem_read(KERNAL_FNADR) | (mem_read(KERNAL_FNADR + 1) << 8));
+    for (i = 0; i < length; i++) {
+        name[i] = mem_read((uint16_t)(name_addr + i));
+    }
+
+    if (vdrive_iec_open(vdrive, name, length, 0, NULL) != SERIAL_OK) {
+        vdrive_iec_close(vdrive, 0);
+        return 0;
+    }
+
+    /* load address */
+    if (vdrive_iec_read(vdrive, &data, 0) != SERIAL_OK) {
+        vdrive_iec_close(vdrive, 0);
+        return 0;
+    }
+    addr = data;
+    if (vdrive_iec_read(vdrive, &data, 0) != SERIAL_OK) {
+        vdrive_iec_close(vdrive, 0);
+        return 0;
+    }
+    addr |= data << 8;
+
+    sa = mem_read(KERNAL_SA);
+    if (sa == 0) {
+        addr = (uint16_t)(mem_read(KERNAL_MEMUSS) | (mem_read(KERNAL_MEMUSS + 1) << 8));
+    }
+    verify = mem_read(KERNAL_VERIFY);
+
+    do {
+        status = vdrive_iec_read(vdrive, &data, 0);
+        if (status == SERIAL_ERROR) {
+            break;
+        }
+        if (verify) {
+            if (mem_read(addr) != data) {
+                st |= 0x10;
+            }
+        } else {
+            mem_store(addr, data);
+        }
+        addr++;
+    } while (status != SERIAL_EOF);
+
+    vdrive_iec_close(vdrive, 0);
+
+    mem_store(KERNAL_SA, 0x60);
+    mem_store(KERNAL_STATUS, (uint8_t)(st | 0x40));
+    mem_store(KERNAL_EAL, (uint8_t)(addr & 0xff));
+    mem_store(KERNAL_EAL + 1, (uint8_t)(addr >> 8));
+
+    return 1;
+}
+
+static int set_fastload_enabled(int val, void *param)
+{
+    serial_fastload_enabled = val ? 1 : 0;
+
+    return 0;
+}
+
+static const resource_int_t resources_int[] = {
+    { "DriveFastLoad", 0, RES_EVENT_SAME, NULL,
+      &serial_fastload_enabled, set_fastload_enabled, NULL },
+    RESOURCE_INT_LIST_END
+};
+
+static const cmdline_option_t cmdline_options[] =
+{
+    { "-drivefastload", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
+      NULL, NULL, "DriveFastLoad", (resource_value_t)1,
+      NULL, "Load files from true drive images directly, unless the drive runs custom code" },
+    { "+drivefastload", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
+      NULL, NULL, "DriveFastLoad", (resource_value_t)0,
+      NULL, "Always load files from true drives through the emulated serial bus" },
+    CMDLINE_LIST_END
+};
+
 /* Initializing the IEC bus and IEC device will move once serial.c is not
    referenced by PET and CBM2 anymore. */
 int serial_resources_init(void)
 {
+    if (resources_register_int(resources_int) < 0) {
+        return -1;
+    }
     return serial_iec_device_resources_init();
 }
 
 int serial_cmdline_options_init(void)
 {
+    if (cmdline_register_options(cmdline_options) < 0) {
+        return -1;
+    }
     return serial_iec_device_cmdline_options_init();
 }
 
@@ -262,8 +454,14 @@ void serial_trap_init(uint16_t tmpin)
 /* called by machine_specific_reset() */
 void serial_traps_reset(void)
 {
+    unsigned int i;
+
     serial_iec_bus_reset();
     serial_iec_device_reset();
+
+    for (i = 0; i < NUM_DISK_UNITS; i++) {
+        custom_drive_code[i] = 0;
+    }
 }
 
 /* Specify a function to call when EOF happens in `serialreceivebyte()'.  */
@@ -282,3 +480,70 @@ void serial_trap_truedrive_set(unsigned int flag)
 {
     serial_truedrive = flag;
 }
+
+/* ------------------------------------------------------------------------- */
+/*    snapshot support functions                                             */
+
+#define SNAP_MAJOR 1
+#define SNAP_MINOR 0
+#define SNAP_NAME  "SERIALTRAP"
+
+/* The custom drive code flags decide whether serial_trap_load() bypasses the
+   drive, so they have to survive a snapshot for history playback to take
+   the same path as the recording.  */
+int serial_trap_snapshot_write_module(snapshot_t *s)
+{
+    snapshot_module_t *m;
+    unsigned int i;
+
+    m = snapshot_module_create(s, SNAP_NAME, SNAP_MAJOR, SNAP_MINOR);
+
+    if (m == NULL) {
+        return -1;
+    }
+
+    for (i = 0; i < NUM_DISK_UNITS; i++) {
+        if (SMW_B(m, (uint8_t)custom_drive_code[i]) < 0) {
+            snapshot_module_close(m);
+            return -1;
+        }
+    }
+
+    return snapshot_module_close(m);
+}
+
+int serial_trap_snapshot_read_module(snapshot_t *s)
+{
+    uint8_t major_version, minor_version, flag;
+    snapshot_module_t *m;
+    unsigned int i;
+
+    for (i = 0; i < NUM_DISK_UNITS; i++) {
+        custom_drive_code[i] = 0;
+    }
+    drive_command_len = 0;
+
+    m = snapshot_module_open(s, SNAP_NAME, &major_version, &minor_version);
+
+    /* Older snapshots don't have this module.  */
+    if (m == NULL) {
+        return 0;
+    }
+
+    /* Do not accept versions higher than current */
+    if (snapshot_version_is_bigger(major_version, minor_version, SNAP_MAJOR, SNAP_MINOR)) {
+        snapshot_set_error(SNAPSHOT_MODULE_HIGHER_VERSION);
+        snapshot_module_close(m);
+        return -1;
+    }
+
+    for (i = 0; i < NUM_DISK_UNITS; i++) {
+        if (SMR_B(m, &flag) < 0) {
+            snapshot_module_close(m);
+            return -1;
+        }
+        custom_drive_code[i] = flag;
+    }
+
+    return snapshot_module_close(m);
+}
@@ -95,6 +95,14 @@ typedef struct tap_s {
 
     /* Has the tap changed? We correct the size then.  */
     int has_changed;
+
+    /* In-memory copy of the image, used when scanning it for files.  */
+    uint8_t *data;
+    long data_size;
+    long data_pos;
+
+    /* Has the image been written since the copy was made?  */
+    int data_stale;
 } tap_t;
 
 extern void tap_init(const struct tape_init_s *init);
@@ -112,6 +112,7 @@ static tap_t *tap_new(void)
     tap->current_file_number = -1;
     tap->current_file_data = NULL;
     tap->current_file_size = 0;
+    tap->data_pos = tap->offset;
 
     return tap;
 }
@@ -182,6 +183,7 @@ int tap_close(tap_t *tap)
     }
 
     lib_free(tap->current_file_data);
+    lib_free(tap->data);
     lib_free(tap->file_name);
     lib_free(tap->tap_file_record);
     lib_free(tap);
@@ -222,6 +224,77 @@ int tap_create(const char *name)
 }
 
 
+/* ------------------------------------------------------------------------- */
+
+/* Scanning the image for files reads it pulse by pulse and seeks back and
+   forth a lot, so it works on an in-memory copy of the whole file.  Offsets
+   are file offsets, including the header.  */
+
+static int tap_data_update(tap_t *tap)
+{
+    long size, fpos;
+
+    if (tap->data != NULL && !tap->data_stale) {
+        return 0;
+    }
+
+    lib_free(tap->data);
+    tap->data = NULL;
+    tap->data_size = 0;
+    tap->data_stale = 0;
+
+    size = (long)util_file_length(tap->fd);
+    if (size <= 0) {
+        return -1;
+    }
+
+    /* the datasette may be reading or recording at the current position */
+    fpos = ftell(tap->fd);
+
+    tap->data = lib_malloc(size);
+    if (util_fpread(tap->fd, tap->data, size, 0) < 0) {
+        lib_free(tap->data);
+        tap->data = NULL;
+        fseek(tap->fd, fpos, SEEK_SET);
+        return -1;
+    }
+    tap->data_size = size;
+    if (tap->data_pos > size) {
+        tap->data_pos = size;
+    }
+
+    fseek(tap->fd, fpos, SEEK_SET);
+
+    return 0;
+}
+
+inline static long tap_data_tell(tap_t *tap)
+{
+    return tap->data_pos;
+}
+
+inline static void tap_data_seek(tap_t *tap, long pos)
+{
+    /* seeking to the start happens before the copy is first read */
+    if (pos < 0) {
+        pos = 0;
+    } else if (tap->data != NULL && pos > tap->data_size) {
+        pos = tap->data_size;
+    }
+    tap->data_pos = pos;
+}
+
+inline static long tap_data_read(tap_t *tap, uint8_t *buf, long num)
+{
+    if (num > tap->data_size - tap->data_pos) {
+        num = tap->data_size - tap->data_pos;
+    }
+    memcpy(buf, tap->data + tap->data_pos, num);
+    tap->data_pos += num;
+
+    return num;
+}
+
 /* ------------------------------------------------------------------------- */
 
 static int tap_find_pilot(tap_t *tap, int type);
@@ -230,10 +303,10 @@ inline static int tap_get_pulse(tap_t *tap, int *pos_advance)
 {
     uint8_t data;
     uint32_t pulse_length = 0;
-    size_t res;
+    long res;
 
     *pos_advance = 0;
-    res = fread(&data, 1, 1, tap->fd);
+    res = tap_data_read(tap, &data, 1);
 
     if (res == 0) {
         return -1;
@@ -246,8 +319,8 @@ inline static int tap_get_pulse(tap_t *tap, int *pos_advance)
             pulse_length = 256;
         } else if ((tap->version == 1) || (tap->version == 2)) {
             uint8_t size[3];
-            res = fread(size, 3, 1, tap->fd);
-            if (res == 0) {
+            res = tap_data_read(tap, size, 3);
+            if (res < 3) {
                 return -1;
             }
             *pos_advance += 3;
@@ -261,7 +334,7 @@ inline static int tap_get_pulse(tap_t *tap, int *pos_advance)
     if (tap->version == 2) {
         uint32_t pulse_length2;
 
-        res = fread(&data, 1, 1, tap->fd);
+        res = tap_data_read(tap, &data, 1);
 
         if (res == 0) {
             return -1;
@@ -269,8 +342,8 @@ inline static int tap_get_pulse(tap_t *tap, int *pos_advance)
         *pos_advance += (int)res;
         if (data == 0) {
             uint8_t size[3];
-            res = fread(size, 3, 1, tap->fd);
-            if (res == 0) {
+            res = tap_data_read(tap, size, 3);
+            if (res < 3) {
                 return -1;
             }
             *pos_advance += 3;
@@ -382,7 +455,7 @@ static int tap_cbm_skip_pilot(tap_t *tap)
 
     errors = 0;
     counter = 0;
-    current_filepos = ftell(tap->fd);
+    current_filepos = tap_data_tell(tap);
     while (1) {
         /*  Save file position */
         fpos = current_filepos;
@@ -391,7 +464,7 @@ static int tap_cbm_skip_pilot(tap_t *tap)
         fpos2 = current_filepos;
         if (TAP_PULSE_LONG(data)) {
             /* found an L pulse, try to read a byte */
-            fseek(tap->fd, fpos, SEEK_SET);
+            tap_data_seek(tap, fpos);
             current_filepos = fpos;
             data = tap_cbm_read_byte(tap);
             if (data == -1) {
@@ -404,12 +477,12 @@ static int tap_cbm_skip_pilot(tap_t *tap)
                 }
 
                 /* Start over after the L pulse */
-                fseek(tap->fd, fpos2, SEEK_SET);
+                tap_data_seek(tap, fpos2);
                 current_filepos = fpos2;
                 counter = 0;
             } else {
                 /* success.  Go back to start of byte and return */
-                fseek(tap->fd, fpos, SEEK_SET);
+                tap_data_seek(tap, fpos);
                 current_filepos = fpos;
                 return 0;
             }
@@ -766,13 +839,13 @@ static int tap_cbm_skip_file(tap_t *tap)
         int ret;
 
         while (1) {
-            fpos = ftell(tap->fd);
+            fpos = tap_data_tell(tap);
 
             /* find next pilot */
             ret = tap_find_pilot(tap, PILOT_TYPE_CBM);
             if (ret < 0) {
                 /* no more pilot found => end of data */
-                fseek(tap->fd, fpos, SEEK_SET);
+                tap_data_seek(tap, fpos);
                 break;
             }
 
@@ -780,7 +853,7 @@ static int tap_cbm_skip_file(tap_t *tap)
             ret = tap_cbm_read_block(tap, buffer, 193);
             if (ret < 1 || buffer[0] != 2) {
                 /* next block is not a data continuation block => end of data */
-                fseek(tap->fd, fpos, SEEK_SET);
+                tap_data_seek(tap, fpos);
                 break;
             }
         }
@@ -847,7 +920,7 @@ static int tap_tt_skip_pilot(tap_t *tap)
     int data;
 
 #if TAP_DEBUG > 1
-    log_debug("\nTAP_TT_SKIP_PILOT(0x%X", ftell(tap->fd));
+    log_debug("\nTAP_TT_SKIP_PILOT(0x%X", tap_data_tell(tap));
 #endif
 
     /* turbo-tape pilot is just repeats of value 0x02 */
@@ -860,12 +933,12 @@ static int tap_tt_skip_pilot(tap_t *tap)
         if (data != 2) {
             /* value != 0x02, we found the end of the pilot.  Go back
                so byte can be read again */
-            fseek(tap->fd, -8, SEEK_CUR);
+            tap_data_seek(tap, tap_data_tell(tap) - 8);
         }
     } while (data == 2);
 
 #if TAP_DEBUG > 1
-    log_debug("-0x%X) ", ftell(tap->fd));
+    log_debug("-0x%X) ", tap_data_tell(tap));
 #endif
 
     return 0;
@@ -1103,7 +1176,7 @@ static int tap_find_pilot(tap_t *tap, int type)
        file */
     minCBM = (type == PILOT_TYPE_ANY) ? 1000 : PILOT_MIN_LENGTH_CBM;
 
-    startCBM = ftell(tap->fd);
+    startCBM = tap_data_tell(tap);
     startTT = startCBM;
     countCBM = 0;
     countTT = 0;
@@ -1113,9 +1186,8 @@ static int tap_find_pilot(tap_t *tap, int type)
 #endif
 
     while ((countCBM < minCBM) && (countTT < PILOT_MIN_LENGTH_TT * 8)) {
-/*        count = fread(&data, 1, 256, tap->fd); */
-        long startpos = ftell(tap->fd);
-        long readlen = fread(buffer, 1, 256, tap->fd);
+        long startpos = tap_data_tell(tap);
+        long readlen = tap_data_read(tap, buffer, 256);
         uint32_t pulse_length = 0;
         int j = 0;
         long needed;
@@ -1136,7 +1208,7 @@ static int tap_find_pilot(tap_t *tap, int type)
                         /* There is not enough in the buffer
                            Read some more */
                         memcpy(buffer, buffer + i + 1, still_in_buffer);
-                        res = fread(buffer + still_in_buffer, 1, needed, tap->fd);
+                        res = tap_data_read(tap, buffer + still_in_buffer, needed);
                         i = readlen;
                         if (res == 0) {
                             continue;
@@ -1154,7 +1226,7 @@ static int tap_find_pilot(tap_t *tap, int type)
                 uint32_t pulse_length2;
                 /*  Read one more byte if run out of buffer */
                 if (i == readlen) {
-                    readlen = fread(buffer, 1, 1, tap->fd);
+                    readlen = tap_data_read(tap, buffer, 1);
                     if (readlen == 0) {
                         continue;
                     }
@@ -1170,7 +1242,7 @@ static int tap_find_pilot(tap_t *tap, int type)
                         /* There is not enough in the buffer
                            Read some more */
                         memcpy(buffer, buffer + i + 1, still_in_buffer);
-                        res = (int)fread(buffer + still_in_buffer, 1, needed, tap->fd);
+                        res = tap_data_read(tap, buffer + still_in_buffer, needed);
                         i = readlen;
                         if (res == 0) {
                             continue;
@@ -1186,14 +1258,14 @@ static int tap_find_pilot(tap_t *tap, int type)
             j++;
         }
         count = j;
-        pos[j] = ftell(tap->fd);
+        pos[j] = tap_data_tell(tap);
 
 /*        for (i = 0, count = 0; i < 256; i++, count++) {
-            pos[i] = ftell(tap->fd);
+            pos[i] = tap_data_tell(tap);
             data[i] = tap_get_pulse(tap);
             if (data[i] < 0) break;
         }
-        pos[i] = ftell(tap->fd);*/
+        pos[i] = tap_data_tell(tap);*/
         if (count < 1) {
             return -1;
         }
@@ -1254,10 +1326,10 @@ static int tap_find_pilot(tap_t *tap, int type)
         /* startTT points to a '1' bit which we assume to be part of the
            value 00000010.  Skip over the 1 and following 0 so we start
            at the beginning of a 00000010 sequence */
-        fseek(tap->fd, startTT + 2, SEEK_SET);
+        tap_data_seek(tap, startTT + 2);
         return 1;
     } else {
-        fseek(tap->fd, startCBM, SEEK_SET);
+        tap_data_seek(tap, startCBM);
         return 0;
     }
 }
@@ -1277,14 +1349,14 @@ static int tap_find_header(tap_t *tap)
         }
 
         /* store current position in TAP file */
-        fpos = ftell(tap->fd);
+        fpos = tap_data_tell(tap);
 
         /* try to read a header */
         if (type == PILOT_TYPE_CBM) {
             res = tap_cbm_read_header(tap);
             if (res < 0) {
                 int pulse;
-                fseek(tap->fd, fpos, SEEK_SET);
+                tap_data_seek(tap, fpos);
                 do {
                     int pos_advance;
                     pulse = tap_get_pulse(tap, &pos_advance);
@@ -1293,7 +1365,7 @@ static int tap_find_header(tap_t *tap)
         } else if (type == PILOT_TYPE_TT) {
             res = tap_tt_read_header(tap);
             if (res < 0) {
-                fseek(tap->fd, fpos, SEEK_SET);
+                tap_data_seek(tap, fpos);
                 tap_tt_skip_pilot(tap);
             }
         } else {
@@ -1307,7 +1379,7 @@ static int tap_find_header(tap_t *tap)
             }
 
             /* success.  Rewind to start of header and return. */
-            fseek(tap->fd, fpos, SEEK_SET);
+            tap_data_seek(tap, fpos);
             tap->current_file_seek_position = (int)fpos;
             return type;
         }
@@ -1325,7 +1397,7 @@ static int tap_read_file(tap_t *tap)
 #endif
 
     /* store current position in TAP file */
-    fpos = ftell(tap->fd);
+    fpos = tap_data_tell(tap);
 
     /* clear old file data */
     tap->current_file_size = 0;
@@ -1351,7 +1423,7 @@ static int tap_read_file(tap_t *tap)
     }
 
     /* go back to previous position in TAP file */
-    fseek(tap->fd, fpos, SEEK_SET);
+    tap_data_seek(tap, fpos);
 
 #if TAP_DEBUG > 0
     log_debug("\nTAP_READ_FILE(END%i)\n", ret);
@@ -1410,6 +1482,7 @@ int tap_seek_start(tap_t *tap)
     tap->current_file_number = -1;
     tap->current_file_seek_position = 0;
     fseek(tap->fd, tap->offset, SEEK_SET);
+    tap_data_seek(tap, tap->offset);
     return 0;
 }
 
@@ -1427,7 +1500,7 @@ int tap_seek_to_file(tap_t *tap, unsigned int file_number)
 
 int tap_seek_to_next_file(tap_t *tap, unsigned int allow_rewind)
 {
-    if (tap == NULL) {
+    if (tap == NULL || tap_data_update(tap) < 0) {
         return -1;
     }
 
@@ -1471,7 +1544,7 @@ int tap_read(tap_t *tap, uint8_t *buf, size_t size)
                 }
             }
 
-            if (tap_read_file(tap) < 0) {
+            if (tap_data_update(tap) < 0 || tap_read_file(tap) < 0) {
                 return -1; /* reading the file failed */
             } else {
                 tap->current_file_data_pos = 0;
@@ -40,26 +40,28 @@
 
 
 /* Here comes the part that actually repaints each raster line.  This table is
-   used to speed up the drawing. */
-static uint16_t drawing_table[256][256][8]; /* [byte][color][position] */
+   used to speed up the drawing.  Only bit 3 of the color (multicolor) affects
+   the pixel indices, so the table is kept small enough to stay in the data
+   cache while a whole line is drawn.  */
+static uint8_t drawing_table[2][256][8]; /* [multicolor][byte][position] */
+
+/* Row of `drawing_table' for graphics byte `d' and color `b'.  */
+#define DRAWING_ROW(d, b) (drawing_table[((b) >> 3) & 1][(d)])
 
 static void init_drawing_tables(void)
 {
-    unsigned int byte, color, pos;
+    unsigned int byte, pos;
 
     for (byte = 0; byte < 0x100; byte++) {
-        for (color = 0; color < 0x100; color++) {
-            if (color & 0x8) {         /* Multicolor mode. */
-                for (pos = 0; pos < 8; pos += 2) {
-                    drawing_table[byte][color][pos]
-                        = drawing_table[byte][color][pos + 1]
-                              = (byte >> (6 - pos)) & 0x3;
-                }
-            } else {                   /* Standard mode. */
-                for (pos = 0; pos < 8; pos++) {
-                    drawing_table[byte][color][pos] = ((byte >> (7 - pos)) & 0x1) * 2;
-                }
-            }
+        /* Standard mode. */
+        for (pos = 0; pos < 8; pos++) {
+            drawing_table[0][byte][pos] = ((byte >> (7 - pos)) & 0x1) * 2;
+        }
+        /* Multicolor mode. */
+        for (pos = 0; pos < 8; pos += 2) {
+            drawing_table[1][byte][pos]
+                = drawing_table[1][byte][pos + 1]
+                      = (byte >> (6 - pos)) & 0x3;
         }
     }
 }
@@ -104,8 +106,8 @@ static int fill_cache(raster_cache_t *cache, unsigned int *xs,
 }
 
 #define PUT_PIXEL(p, d, c, b, x, t)                                    \
-    if (!t || drawing_table[(d)][(b)][(x)]) {                          \
-        *((VIC_PIXEL *)(p) + (x)) = (c)[drawing_table[(d)][(b)][(x)]]; \
+    if (!t || DRAWING_ROW(d, b)[(x)]) {                                \
+        *((VIC_PIXEL *)(p) + (x)) = (c)[DRAWING_ROW(d, b)[(x)]];       \
     }
 
 inline static void draw(uint8_t *p, unsigned int xs, unsigned int xe,
@@ -181,12 +183,31 @@ inline static void draw(uint8_t *p, unsigned int xs, unsigned int xe,
     c[1] = VIC_PIXEL(vic.mc_border_color);
     c[3] = VIC_PIXEL(vic.auxiliary_color);
     for (i = xs; (int)i <= (int)xe; i++, p += 8 * VIC_PIXEL_WIDTH) {
+        const uint8_t *row;
+
         b = cbuf[i];
         c[2] = VIC_PIXEL(b & 0x7);
         d = gbuf[i];
         dr = (vic.reverse & !(b & 0x8)) ? ~d : d;
-        for (x = 0; x < 8; x++) {
-            PUT_PIXEL(p, dr, c, b, x, transparent);
+        row = DRAWING_ROW(dr, b);
+        if (!transparent) {
+            /* Opaque draw of a whole line, no need to test each pixel.  */
+            VIC_PIXEL *q = (VIC_PIXEL *)p;
+
+            q[0] = c[row[0]];
+            q[1] = c[row[1]];
+            q[2] = c[row[2]];
+            q[3] = c[row[3]];
+            q[4] = c[row[4]];
+            q[5] = c[row[5]];
+            q[6] = c[row[6]];
+            q[7] = c[row[7]];
+        } else {
+            for (x = 0; x < 8; x++) {
+                if (row[x]) {
+                    *((VIC_PIXEL *)p + x) = c[row[x]];
+                }
+            }
         }
     }
 }
@@ -141,6 +141,20 @@ static int warp_enabled;
 static unsigned long warp_render_tick_interval;
 static unsigned long warp_next_render_tick;
 
+/* Render only every nth frame in warp mode, 0 to limit to 10fps instead. */
+static int warp_render_interval;
+
+/* Warp statistics, logged when leaving warp mode. */
+static unsigned long warp_start_tick;
+static unsigned long warp_frames;
+static unsigned long warp_rendered_frames;
+
+/* Whether the frame that just ended was drawn. */
+static int frame_skipped;
+
+/* Number of frames per second on the real machine. */
+static double refresh_frequency;
+
 /* Triggers the vice thread to update its priorty */
 static volatile int update_thread_priority = 1;
 
@@ -158,8 +172,23 @@ static int set_relative_speed(int val, void *param)
     return 0;
 }
 
+static void log_warp_statistics(void)
+{
+    double seconds = (double)tick_delta(warp_start_tick) / tick_per_second();
+
+    if (warp_frames == 0 || seconds <= 0 || refresh_frequency <= 0) {
+        return;
+    }
+
+    log_message(LOG_DEFAULT, "Warp: %lu frames in %.2f s (%.1f times normal speed), %lu frames rendered.",
+                warp_frames, seconds, warp_frames / refresh_frequency / seconds,
+                warp_rendered_frames);
+}
+
 static int set_warp_mode(int val, void *param)
 {
+    int was_enabled = warp_enabled;
+
     warp_enabled = val ? 1 : 0;
 
     sound_set_warp_mode(warp_enabled);
@@ -167,6 +196,13 @@ static int set_warp_mode(int val, void *param)
     
     if (warp_enabled) {
         warp_next_render_tick = tick_now() + warp_render_tick_interval;
+        if (!was_enabled) {
+            warp_start_tick = tick_now();
+            warp_frames = 0;
+            warp_rendered_frames = 0;
+        }
+    } else if (was_enabled) {
+        log_warp_statistics();
     }
 
     update_thread_priority = 1;
@@ -174,6 +210,17 @@ static int set_warp_mode(int val, void *param)
     return 0;
 }
 
+static int set_warp_render_interval(int val, void *param)
+{
+    if (val < 0) {
+        return -1;
+    }
+
+    warp_render_interval = val;
+
+    return 0;
+}
+
 
 /* Vsync-related resources. */
 static const resource_int_t resources_int[] = {
@@ -182,6 +229,8 @@ static const resource_int_t resources_int[] = {
     { "WarpMode", 0, RES_EVENT_STRICT, (resource_value_t)0,
       /* FIXME: maybe RES_EVENT_NO */
       &warp_enabled, set_warp_mode, NULL },
+    { "WarpRenderInterval", 0, RES_EVENT_NO, NULL,
+      &warp_render_interval, set_warp_render_interval, NULL },
     RESOURCE_INT_LIST_END
 };
 
@@ -205,6 +254,9 @@ static const cmdline_option_t cmdline_options[] =
     { "+warp", SET_RESOURCE, CMDLINE_ATTRIB_NONE,
       NULL, NULL, "WarpMode", (resource_value_t)0,
       NULL, "Disable warp mode" },
+    { "-warprenderinterval", SET_RESOURCE, CMDLINE_ATTRIB_NEED_ARGS,
+      NULL, NULL, "WarpRenderInterval", NULL,
+      "<frames>", "Only render every <frames>th frame in warp mode (0: render at most 10 fps)" },
     CMDLINE_LIST_END
 };
 
@@ -219,9 +271,6 @@ int vsync_cmdline_options_init(void)
    adjusting the refresh rate dynamically for slow host CPU situations. */
 #define MAX_RENDER_SKIP_MS (1000 / 10)
 
-/* Number of frames per second on the real machine. */
-static double refresh_frequency;
-
 /* Number of clock cycles per seconds on the real machine. */
 static long cycles_per_sec;
 
@@ -321,6 +370,11 @@ void vsync_reset_hook(void)
     vsync_suspend_speed_eval();
 }
 
+int vsync_frame_skipped(void)
+{
+    return frame_skipped;
+}
+
 void vsyncarch_get_metrics(double *cpu_percent, double *emulated_fps, int *is_warp_enabled)
 {
     METRIC_LOCK();
@@ -560,6 +614,8 @@ int vsync_do_vsync(struct video_canvas_s *c, int been_skipped)
         return 1;
     }
 
+    frame_skipped = been_skipped;
+
     monitor_vsync_hook();
 
     /*
@@ -599,11 +655,20 @@ int vsync_do_vsync(struct video_canvas_s *c, int been_skipped)
      */
     
     if (warp_enabled) {
-        if (now < warp_next_render_tick) {
+        warp_frames++;
+
+        if (warp_render_interval > 0) {
+            skip_next_frame = (warp_frames % (unsigned long)warp_render_interval) != 0;
+        } else if (now < warp_next_render_tick) {
             skip_next_frame = 1;
-            skipped_redraw_count++;
         } else {
             warp_next_render_tick += warp_render_tick_interval;
+        }
+
+        if (skip_next_frame) {
+            skipped_redraw_count++;
+        } else {
+            warp_rendered_frames++;
             skipped_redraw_count = 0;
         }
     }